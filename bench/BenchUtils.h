@@ -0,0 +1,272 @@
+#ifndef MESH_STRUCTURE_BENCH_UTILS_H
+#define MESH_STRUCTURE_BENCH_UTILS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mesh_structure/Index.h"
+#include "mesh_structure/Parallel.h"
+
+namespace bench {
+
+class Timer {
+public:
+    Timer() : t0_(std::chrono::steady_clock::now()) {}
+    double seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0_).count();
+    }
+private:
+    std::chrono::steady_clock::time_point t0_;
+};
+
+// 取多次运行中的最短时间
+template <class F>
+double best_of(int repeat, F &&f) {
+    double best = 1e300;
+    for (int r = 0; r < repeat; ++r) {
+        Timer t;
+        f();
+        double s = t.seconds();
+        if (s < best) best = s;
+    }
+    return best;
+}
+
+inline long file_size(const std::string &path) {
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
+    return static_cast<long>(f.tellg());
+}
+
+// 整个文件的内容，用于逐字节比较
+inline std::string read_file(const std::string &path) {
+    std::ifstream f(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+// 生成的网格：坐标按点交错存放，单元按单元交错存放，每个单元nv个顶点
+struct GeneratedMesh {
+    int nv;
+    std::vector<double> xyz;
+    std::vector<unsigned long> elem;
+
+    unsigned long nVertex() const { return xyz.size() / 3; }
+    unsigned long nElement() const { return elem.size() / nv; }
+};
+
+// n*n 的结构化三角形网格（每个方格剖分为2个三角形）
+inline GeneratedMesh structured_tri(unsigned long n) {
+    GeneratedMesh m;
+    m.nv = 3;
+    unsigned long np = n + 1;
+    m.xyz.reserve(3 * np * np);
+    m.elem.reserve(6 * n * n);
+    for (unsigned long j = 0; j < np; ++j)
+        for (unsigned long i = 0; i < np; ++i)
+            m.xyz.insert(m.xyz.end(), {double(i) / n, double(j) / n, 0.0});
+    for (unsigned long j = 0; j < n; ++j) {
+        for (unsigned long i = 0; i < n; ++i) {
+            unsigned long a = j * np + i, b = a + 1, c = a + np, d = c + 1;
+            m.elem.insert(m.elem.end(), {a, b, d, a, d, c});
+        }
+    }
+    return m;
+}
+
+// n*n*n 的结构化四面体网格（每个立方体按Kuhn剖分为6个四面体）
+inline GeneratedMesh structured_tet(unsigned long n) {
+    GeneratedMesh m;
+    m.nv = 4;
+    unsigned long np = n + 1;
+    m.xyz.reserve(3 * np * np * np);
+    m.elem.reserve(24 * n * n * n);
+    for (unsigned long k = 0; k < np; ++k)
+        for (unsigned long j = 0; j < np; ++j)
+            for (unsigned long i = 0; i < np; ++i)
+                m.xyz.insert(m.xyz.end(), {double(i) / n, double(j) / n, double(k) / n});
+    const int perm[6][3] = {{1, 2, 4}, {1, 4, 2}, {2, 1, 4}, {2, 4, 1}, {4, 1, 2}, {4, 2, 1}};
+    for (unsigned long k = 0; k < n; ++k) {
+        for (unsigned long j = 0; j < n; ++j) {
+            for (unsigned long i = 0; i < n; ++i) {
+                unsigned long corner[8];
+                for (int c = 0; c < 8; ++c)
+                    corner[c] = ((k + ((c >> 2) & 1)) * np + (j + ((c >> 1) & 1))) * np + (i + (c & 1));
+                for (int t = 0; t < 6; ++t) {
+                    int a = perm[t][0], b = a | perm[t][1];
+                    m.elem.insert(m.elem.end(), {corner[0], corner[a], corner[b], corner[7]});
+                }
+            }
+        }
+    }
+    return m;
+}
+
+// 随机打乱点和单元的编号，模拟局部性差的网格生成器
+inline void shuffle(GeneratedMesh &m, unsigned seed) {
+    std::mt19937_64 rng(seed);
+    unsigned long nv = m.nVertex(), ne = m.nElement();
+    std::vector<unsigned long> vp(nv), ep(ne);
+    for (unsigned long i = 0; i < nv; ++i) vp[i] = i;
+    for (unsigned long i = 0; i < ne; ++i) ep[i] = i;
+    std::shuffle(vp.begin(), vp.end(), rng);
+    std::shuffle(ep.begin(), ep.end(), rng);
+    std::vector<double> xyz(m.xyz.size());
+    for (unsigned long i = 0; i < nv; ++i)
+        for (int d = 0; d < 3; ++d) xyz[3 * vp[i] + d] = m.xyz[3 * i + d];
+    std::vector<unsigned long> elem(m.elem.size());
+    for (unsigned long i = 0; i < ne; ++i)
+        for (int j = 0; j < m.nv; ++j) elem[m.nv * ep[i] + j] = vp[m.elem[m.nv * i + j]];
+    m.xyz.swap(xyz);
+    m.elem.swap(elem);
+}
+
+inline void write_off(const std::string &path, const GeneratedMesh &m) {
+    FILE *f = std::fopen(path.c_str(), "w");
+    std::fprintf(f, "OFF\n%lu %lu 0\n", m.nVertex(), m.nElement());
+    for (unsigned long i = 0; i < m.nVertex(); ++i)
+        std::fprintf(f, "%.15g %.15g %.15g\n", m.xyz[3 * i], m.xyz[3 * i + 1], m.xyz[3 * i + 2]);
+    for (unsigned long i = 0; i < m.nElement(); ++i) {
+        std::fprintf(f, "%d", m.nv);
+        for (int j = 0; j < m.nv; ++j) std::fprintf(f, " %lu", m.elem[m.nv * i + j]);
+        std::fprintf(f, "\n");
+    }
+    std::fclose(f);
+}
+
+// 按编号直接计算点和单元的结构化网格，与structured_tri/structured_tet的编号相同，但不在内存中保存整个网格，
+// 用于生成上亿单元的输入。jitter>0时内部点按点编号确定地随机偏移，每个坐标至多jitter倍网格间距
+class StructuredGenerator {
+public:
+    StructuredGenerator(int nv, unsigned long n, double jitter = 0) : nv_(nv), n_(n), jitter_(jitter) {}
+
+    // 单元数不少于nElement的最小网格
+    static StructuredGenerator with_elements(int nv, unsigned long nElement, double jitter = 0) {
+        unsigned long n = 1;
+        while ((nv == 3 ? 2 * n * n : 6 * n * n * n) < nElement) ++n;
+        return StructuredGenerator(nv, n, jitter);
+    }
+
+    int nv() const { return nv_; }
+    unsigned long nVertex() const { return nv_ == 3 ? (n_ + 1) * (n_ + 1) : (n_ + 1) * (n_ + 1) * (n_ + 1); }
+    unsigned long nElement() const { return nv_ == 3 ? 2 * n_ * n_ : 6 * n_ * n_ * n_; }
+
+    void vertex(unsigned long v, double *p) const {
+        unsigned long np = n_ + 1, c[3] = {v % np, v / np % np, nv_ == 3 ? 0 : v / np / np};
+        uint64_t h = v * 0x9e3779b97f4a7c15ull + 0x632be59bd9b4e5f5ull;
+        for (int d = 0; d < 3; ++d) {
+            p[d] = double(c[d]) / n_;
+            // splitmix64：同一个点的偏移与线程划分无关
+            h += 0x9e3779b97f4a7c15ull;
+            uint64_t z = h;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            z ^= z >> 31;
+            bool interior = c[0] > 0 && c[0] < n_ && c[1] > 0 && c[1] < n_ && (nv_ == 3 || (c[2] > 0 && c[2] < n_));
+            if (jitter_ > 0 && interior && (nv_ == 4 || d < 2))
+                p[d] += jitter_ / n_ * (2.0 * (z >> 11) / 9007199254740992.0 - 1.0);
+        }
+    }
+
+    void element(unsigned long k, unsigned long *out) const {
+        unsigned long np = n_ + 1;
+        if (nv_ == 3) {
+            unsigned long cell = k / 2, a = cell / n_ * np + cell % n_, b = a + 1, c = a + np, d = c + 1;
+            const unsigned long tri[2][3] = {{a, b, d}, {a, d, c}};
+            std::copy(tri[k % 2], tri[k % 2] + 3, out);
+            return;
+        }
+        const int perm[6][3] = {{1, 2, 4}, {1, 4, 2}, {2, 1, 4}, {2, 4, 1}, {4, 1, 2}, {4, 2, 1}};
+        unsigned long cell = k / 6, i = cell % n_, j = cell / n_ % n_, l = cell / n_ / n_;
+        auto corner = [&](int c) { return ((l + ((c >> 2) & 1)) * np + (j + ((c >> 1) & 1))) * np + (i + (c & 1)); };
+        int t = k % 6, a = perm[t][0], b = a | perm[t][1];
+        out[0] = corner(0);
+        out[1] = corner(a);
+        out[2] = corner(b);
+        out[3] = corner(7);
+    }
+
+private:
+    int nv_;
+    unsigned long n_;
+    double jitter_;
+};
+
+// 逐行写出生成的网格，不保存整个网格
+inline void write_off(const std::string &path, const StructuredGenerator &g) {
+    FILE *f = std::fopen(path.c_str(), "w");
+    std::vector<char> buffer(1 << 22);
+    std::setvbuf(f, buffer.data(), _IOFBF, buffer.size());
+    std::fprintf(f, "OFF\n%lu %lu 0\n", g.nVertex(), g.nElement());
+    double p[3];
+    for (unsigned long v = 0; v < g.nVertex(); ++v) {
+        g.vertex(v, p);
+        std::fprintf(f, "%.15g %.15g %.15g\n", p[0], p[1], p[2]);
+    }
+    unsigned long e[4];
+    for (unsigned long k = 0; k < g.nElement(); ++k) {
+        g.element(k, e);
+        if (g.nv() == 3) std::fprintf(f, "3 %lu %lu %lu\n", e[0], e[1], e[2]);
+        else std::fprintf(f, "4 %lu %lu %lu %lu\n", e[0], e[1], e[2], e[3]);
+    }
+    std::fclose(f);
+}
+
+// 不经文件，直接把生成的网格并行写入网格的数组
+template <class M>
+void fill_mesh(M &m, const StructuredGenerator &g, unsigned nthreads) {
+    m.allocate(g.nVertex(), g.nElement());
+    double *x = m.x_coord(), *y = m.y_coord(), *z = m.z_coord();
+    mesh_structure::index_t **elem = m.element();
+    mesh_structure::parallel_for(0, g.nVertex(), nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        double p[3];
+        for (unsigned long v = lo; v < hi; ++v) {
+            g.vertex(v, p);
+            x[v] = p[0];
+            y[v] = p[1];
+            z[v] = p[2];
+        }
+    });
+    mesh_structure::parallel_for(0, g.nElement(), nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        unsigned long e[4];
+        for (unsigned long k = lo; k < hi; ++k) {
+            g.element(k, e);
+            for (int j = 0; j < g.nv(); ++j) elem[j][k] = e[j];
+        }
+    });
+}
+
+// 峰值常驻内存（/proc/self/status中的VmHWM），单位KB，读不到时为-1
+inline long peak_rss_kb() {
+    std::ifstream f("/proc/self/status");
+    std::string line;
+    while (std::getline(f, line))
+        if (line.compare(0, 6, "VmHWM:") == 0) return std::strtol(line.c_str() + 6, nullptr, 10);
+    return -1;
+}
+
+// 把峰值常驻内存重置为当前值，使之后的peak_rss_kb只反映下一步操作（Linux 4.0起支持，不支持时忽略）
+inline void reset_peak_rss() {
+    std::ofstream f("/proc/self/clear_refs");
+    if (f) f << "5";
+}
+
+inline void write_structured_tri_off(const std::string &path, unsigned long n) {
+    write_off(path, structured_tri(n));
+}
+
+inline void write_structured_tet_off(const std::string &path, unsigned long n) {
+    write_off(path, structured_tet(n));
+}
+
+}  // namespace bench
+
+#endif // MESH_STRUCTURE_BENCH_UTILS_H
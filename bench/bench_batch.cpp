@@ -0,0 +1,120 @@
+// 批量读入：生成许多小的三角形和四面体网格及少量大的四面体网格，比较逐个read_off加提取子实体与BatchLoader的时间，
+// 并校验：每个网格的结果与逐个读入的相同、内存预算内处理中的估计内存不超过预算、
+// 作业占用的线程数合计不超过线程池的线程数、读入出错时由future抛出FileError
+// 用法: bench_batch [小网格数] [大网格边长n] [最大线程数] [内存预算MB，0为不限]
+
+#include <thread>
+
+#include "BenchUtils.h"
+#include "mesh_structure/BatchLoader.h"
+#include "mesh_structure/TetrahedronMesh.h"
+#include "mesh_structure/TriangleMesh.h"
+
+using mesh_structure::BatchLoader;
+using mesh_structure::index_t;
+
+// 子实体表相同即认为提取结果相同
+template <class M>
+static bool same(M &a, M &b) {
+    if (a.getNVertex() != b.getNVertex() || a.getNElement() != b.getNElement() || a.getNSub() != b.getNSub() ||
+        a.getNBoundary() != b.getNBoundary())
+        return false;
+    for (int k = 0; k < M::SV + 2; ++k)
+        if (!std::equal(a.sub_info()[k], a.sub_info()[k] + a.getNSub(), b.sub_info()[k])) return false;
+    return true;
+}
+
+int main(int argc, char **argv) {
+    unsigned long nsmall = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+    unsigned long nbig = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 40;
+    unsigned max_threads = argc > 3 ? std::atoi(argv[3]) : std::thread::hardware_concurrency();
+    size_t budget = (argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 64) << 20;
+    if (max_threads == 0) max_threads = 1;
+    int status = 0;
+
+    // 小网格的规模各不相同，两个大网格在列表的末尾
+    std::vector<std::string> tri_paths, tet_paths;
+    for (unsigned long k = 0; k < nsmall; ++k) {
+        std::string p = "bench_batch_" + std::to_string(k) + ".off";
+        if (k % 2 == 0) {
+            bench::write_off(p, bench::structured_tri(20 + 7 * (k % 13)));
+            tri_paths.push_back(p);
+        } else {
+            bench::write_off(p, bench::structured_tet(6 + k % 11));
+            tet_paths.push_back(p);
+        }
+    }
+    for (int k = 0; k < 2; ++k) {
+        std::string p = "bench_batch_big" + std::to_string(k) + ".off";
+        bench::write_off(p, bench::structured_tet(k == 0 ? nbig : std::max(nbig / 2, 1ul)));
+        tet_paths.push_back(p);
+    }
+    std::cout << tri_paths.size() << " triangle and " << tet_paths.size() << " tetrahedron meshes" << std::endl;
+
+    size_t largest = 0;
+    for (const std::string &p : tri_paths) largest = std::max(largest, BatchLoader::estimate_bytes<TriangleMesh>(p));
+    for (const std::string &p : tet_paths) largest = std::max(largest, BatchLoader::estimate_bytes<TetrahedronMesh>(p));
+
+    std::vector<TriangleMesh> tri_ref(tri_paths.size());
+    std::vector<TetrahedronMesh> tet_ref(tet_paths.size());
+    bench::Timer ts;
+    for (size_t k = 0; k < tri_paths.size(); ++k) {
+        tri_ref[k].setNumThreads(1);
+        tri_ref[k].read_off(tri_paths[k]);
+        tri_ref[k].collect_edges();
+    }
+    for (size_t k = 0; k < tet_paths.size(); ++k) {
+        tet_ref[k].setNumThreads(1);
+        tet_ref[k].read_off(tet_paths[k]);
+        tet_ref[k].collect_faces();
+    }
+    std::cout << "serial" << std::fixed << std::setprecision(4) << std::setw(27) << ts.seconds() << " s" << std::endl;
+
+    for (unsigned nt = 1; nt <= max_threads; nt *= 2) {
+        for (size_t b : {size_t(0), budget}) {
+            BatchLoader loader(nt, b);
+            bench::Timer tb;
+            auto tri = loader.submit_all<TriangleMesh>(tri_paths);
+            auto tet = loader.submit_all<TetrahedronMesh>(tet_paths);
+            std::vector<TriangleMesh> tri_mesh;
+            std::vector<TetrahedronMesh> tet_mesh;
+            for (auto &f : tri) tri_mesh.push_back(f.get());
+            for (auto &f : tet) tet_mesh.push_back(f.get());
+            double t = tb.seconds();
+            std::cout << "batch x" << std::left << std::setw(4) << nt << std::right << " budget " << std::setw(6)
+                      << (b >> 20) << " MB " << std::setw(8) << t << " s   peak in flight " << std::setw(8)
+                      << loader.peak_bytes_in_flight() / 1048576.0 << " MB" << std::endl;
+            bool ok = true;
+            for (size_t k = 0; k < tri_mesh.size(); ++k) ok = ok && same(tri_mesh[k], tri_ref[k]);
+            for (size_t k = 0; k < tet_mesh.size(); ++k) ok = ok && same(tet_mesh[k], tet_ref[k]);
+            if (!ok) {
+                std::cout << "batch results differ from serial loading!" << std::endl;
+                status = 1;
+            }
+            // 单个作业超出预算时它单独执行，上限为预算与最大作业中较大的
+            if (b != 0 && loader.peak_bytes_in_flight() > std::max(b, largest)) {
+                std::cout << "memory in flight exceeds the budget!" << std::endl;
+                status = 1;
+            }
+            // 网格内部并行的线程与其他作业的线程合计不超过线程池的线程数
+            if (loader.peak_threads_in_use() > loader.getNumThreads()) {
+                std::cout << "threads in use exceed the pool size!" << std::endl;
+                status = 1;
+            }
+        }
+    }
+
+    BatchLoader loader(max_threads);
+    auto missing = loader.submit<TetrahedronMesh>("bench_batch_missing.off");
+    try {
+        missing.get();
+        std::cout << "missing file was not reported!" << std::endl;
+        status = 1;
+    } catch (const mesh_structure::FileError &e) {
+        std::cout << "missing file reported: " << e.what() << std::endl;
+    }
+
+    for (const std::string &p : tri_paths) std::remove(p.c_str());
+    for (const std::string &p : tet_paths) std::remove(p.c_str());
+    return status;
+}
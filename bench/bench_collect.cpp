@@ -0,0 +1,223 @@
+// 比较哈希去重的collect_edges/collect_faces与原逐顶点查找实现，并校验结果完全一致
+// 线程数大于1时使用并行排序路径；另校验由快照读入的网格可以写回同一路径，外存模式的快照与内存中提取的相同
+// 用法: bench_collect [三角形网格边长n] [四面体网格边长n] [重复次数] [最大线程数]
+
+#include <thread>
+#include <type_traits>
+
+#include "BenchUtils.h"
+#include "mesh_structure/OutOfCoreTopology.h"
+#include "mesh_structure/TriangleMesh.h"
+#include "mesh_structure/TetrahedronMesh.h"
+
+namespace legacy {
+
+// 原实现：每个顶点最多max_n个子实体，每个槽位一个int[nVertex]数组
+// 结果按列存放：nsv个顶点、2个相邻单元、nsub列conn、2列order
+struct Topology {
+    unsigned long n;
+    std::vector<unsigned long> entity[5];
+    std::vector<unsigned long> conn[4];
+    std::vector<unsigned long> order[2];
+    std::vector<unsigned long> boundary;
+};
+
+template <int NS, int SV>
+void collect(unsigned long nVertex, unsigned long nElement, mesh_structure::index_t *const *elem,
+             const int (&iv)[NS][SV], int max_n, Topology &out) {
+    std::vector<std::vector<unsigned long>> ents;
+    std::vector<int *> local(max_n);
+    for (int i = 0; i < max_n; i++) local[i] = new int[nVertex];
+    int *nlocal = new int[nVertex];
+    for (unsigned long j = 0; j < nVertex; j++) nlocal[j] = 0;
+    for (int j = 0; j < NS; j++) out.conn[j].assign(nElement, 0);
+
+    unsigned long n = 0;
+    for (unsigned long i = 0; i < nElement; ++i) {
+        for (int j = 0; j < NS; j++) {
+            std::vector<unsigned long> giv(SV);
+            for (int a = 0; a < SV; a++) giv[a] = elem[iv[j][a]][i];
+            std::sort(giv.begin(), giv.end());
+            int k;
+            for (k = 0; k < nlocal[giv[0]]; k++) {
+                std::vector<unsigned long> &f = ents[local[k][giv[0]]];
+                if (std::equal(giv.begin() + 1, giv.end(), f.begin() + 1)) {
+                    f[SV + 1] = i;
+                    out.conn[j][i] = local[k][giv[0]];
+                    break;
+                }
+            }
+            if (k == nlocal[giv[0]]) {
+                giv.push_back(i);
+                giv.push_back(nElement + 1);
+                ents.push_back(giv);
+                local[nlocal[giv[0]]][giv[0]] = n;
+                out.conn[j][i] = n;
+                ++n;
+                ++nlocal[giv[0]];
+            }
+        }
+    }
+    for (int i = 0; i < max_n; i++) delete[] local[i];
+    delete[] nlocal;
+
+    out.n = n;
+    for (int a = 0; a < SV + 2; a++) {
+        out.entity[a].resize(n);
+        for (unsigned long j = 0; j < n; j++) out.entity[a][j] = ents[j][a];
+    }
+    for (int i = 0; i < 2; i++) out.order[i].assign(n, NS);
+    for (unsigned long j = 0; j < n; ++j) {
+        unsigned long ik = out.entity[SV][j], ik_ = out.entity[SV + 1][j];
+        for (int i = 0; i < NS; ++i) {
+            if (out.conn[i][ik] == j) out.order[0][j] = i;
+            if (ik_ < nElement && out.conn[i][ik_] == j) out.order[1][j] = i;
+        }
+    }
+    out.boundary.clear();
+    for (unsigned long j = 0; j < n; j++)
+        if (out.entity[SV + 1][j] == nElement + 1) out.boundary.push_back(j);
+}
+
+}  // namespace legacy
+
+template <int NS, int SV>
+static bool same(const legacy::Topology &ref, unsigned long nElement, unsigned long n,
+                 mesh_structure::index_t **entity, mesh_structure::index_t **conn, mesh_structure::local_t **order,
+                 unsigned long nb, mesh_structure::index_t *boundary) {
+    if (ref.n != n || ref.boundary.size() != nb) return false;
+    for (int a = 0; a < SV + 2; a++)
+        if (!std::equal(ref.entity[a].begin(), ref.entity[a].end(), entity[a])) return false;
+    for (int j = 0; j < NS; j++)
+        if (!std::equal(ref.conn[j].begin(), ref.conn[j].begin() + nElement, conn[j])) return false;
+    for (int i = 0; i < 2; i++)
+        if (!std::equal(ref.order[i].begin(), ref.order[i].end(), order[i])) return false;
+    return std::equal(ref.boundary.begin(), ref.boundary.end(), boundary);
+}
+
+static void report(const char *name, double seconds, unsigned long nelem) {
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(4)
+              << std::setw(10) << seconds << " s" << std::setprecision(2) << std::setw(10)
+              << nelem / seconds / 1e6 << " Melem/s" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    unsigned long ntri = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 300;
+    unsigned long ntet = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 30;
+    int repeat = argc > 3 ? std::atoi(argv[3]) : 3;
+    unsigned max_threads = argc > 4 ? std::atoi(argv[4]) : std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+    int status = 0;
+
+    const std::string tri_path = "bench_collect_tri.off";
+    const std::string tet_path = "bench_collect_tet.off";
+    bench::write_structured_tri_off(tri_path, ntri);
+    bench::write_structured_tet_off(tet_path, ntet);
+
+    {
+        TriangleMesh m;
+        m.read_off(tri_path);
+        static const int iv[3][2] = {{0, 1}, {1, 2}, {2, 0}};
+        legacy::Topology ref;
+        double t = bench::best_of(repeat, [&] {
+            legacy::collect(m.getNVertex(), m.getNTriangle(), m.triangle(), iv, 100, ref);
+        });
+        report("collect_edges legacy", t, m.getNTriangle());
+        for (unsigned nt = 1; nt <= max_threads; nt *= 2) {
+            m.setNumThreads(nt);
+            t = bench::best_of(repeat, [&] { m.collect_edges(); });
+            report(("collect_edges x" + std::to_string(nt)).c_str(), t, m.getNTriangle());
+            if (!same<3, 2>(ref, m.getNTriangle(), m.getNEdge(), m.edge_info(), m.tri_edge_connection(),
+                            m.edge_order_in_tri(), m.getNBoundary(), m.boundary())) {
+                std::cout << "collect_edges result differs from legacy implementation!" << std::endl;
+                status = 1;
+            }
+        }
+    }
+    {
+        TetrahedronMesh m;
+        m.read_off(tet_path);
+        static const int iv[4][3] = {{0, 1, 2}, {0, 2, 3}, {0, 3, 1}, {3, 2, 1}};
+        legacy::Topology ref;
+        double t = bench::best_of(repeat, [&] {
+            legacy::collect(m.getNVertex(), m.getNTetrahedron(), m.tetrahedron(), iv, 300, ref);
+        });
+        report("collect_faces legacy", t, m.getNTetrahedron());
+        for (unsigned nt = 1; nt <= max_threads; nt *= 2) {
+            m.setNumThreads(nt);
+            t = bench::best_of(repeat, [&] { m.collect_faces(); });
+            report(("collect_faces x" + std::to_string(nt)).c_str(), t, m.getNTetrahedron());
+            if (!same<4, 3>(ref, m.getNTetrahedron(), m.getNFace(), m.face_info(), m.tet_face_connection(),
+                            m.face_order_in_tet(), m.getNBoundary(), m.boundary())) {
+                std::cout << "collect_faces result differs from legacy implementation!" << std::endl;
+                status = 1;
+            }
+        }
+
+        // 由快照读入的网格写回同一路径：数组仍指向原文件的映射，写出不能破坏它们，新文件也必须可以读回
+        const std::string snap_path = "bench_collect_tet.snap";
+        m.write_snapshot(snap_path);
+        bool ok = true;
+        try {
+            TetrahedronMesh a, b;
+            a.read_snapshot(snap_path);
+            a.write_snapshot(snap_path);
+            b.read_snapshot(snap_path);
+            ok = same<4, 3>(ref, b.getNTetrahedron(), b.getNFace(), b.face_info(), b.tet_face_connection(),
+                            b.face_order_in_tet(), b.getNBoundary(), b.boundary()) &&
+                 same<4, 3>(ref, a.getNTetrahedron(), a.getNFace(), a.face_info(), a.tet_face_connection(),
+                            a.face_order_in_tet(), a.getNBoundary(), a.boundary());
+        } catch (const mesh_structure::MeshError &e) {
+            std::cout << e.what() << std::endl;
+            ok = false;
+        }
+        if (!ok) {
+            std::cout << "rewriting a snapshot in place lost its contents!" << std::endl;
+            status = 1;
+        }
+        std::remove(snap_path.c_str());
+    }
+
+    // 外存模式：快照必须与read_off + 内存中提取 + write_snapshot的逐字节相同
+    // 预算为0时排序缓冲取下限（共4MB），默认规模的子实体键远大于此，会写出多个有序段并做外部归并
+    auto check_out_of_core = [&](const char *name, auto &m, const std::string &off, auto &&out_of_core) {
+        typedef std::remove_reference_t<decltype(m)> M;
+        const std::string mem_snap = "bench_collect_mem.snap", ooc_snap = "bench_collect_ooc.snap";
+        m.read_off(off);
+        // 第一遍排序（子实体键）在最小预算下的有序段数
+        unsigned long key_bytes = m.getNElement() * M::NS * sizeof(mesh_structure::detail::KeyRecord<M::SV>);
+        std::cout << name << " out-of-core: " << (key_bytes + (2 << 20) - 1) / (2 << 20)
+                  << " sorted runs with the minimum budget" << std::endl;
+        m.collect_sub_entities();
+        m.write_snapshot(mem_snap);
+        for (size_t budget : {size_t(0), size_t(1) << 30}) {
+            bench::Timer t;
+            out_of_core(off, ooc_snap, budget);
+            std::string label = std::string(name) + " out-of-core " + std::to_string(budget >> 20) + " MB";
+            std::cout << std::left << std::setw(28) << label << std::right << std::setw(10) << t.seconds() << " s"
+                      << std::endl;
+            if (bench::read_file(ooc_snap) != bench::read_file(mem_snap)) {
+                std::cout << name << " out-of-core snapshot differs from the in-memory one!" << std::endl;
+                status = 1;
+            }
+        }
+        std::remove(mem_snap.c_str());
+        std::remove(ooc_snap.c_str());
+    };
+    {
+        TriangleMesh m;
+        check_out_of_core("edges", m, tri_path, [](const std::string &off, const std::string &snap, size_t budget) {
+            TriangleMesh::collect_edges_out_of_core(off, snap, budget);
+        });
+    }
+    {
+        TetrahedronMesh m;
+        check_out_of_core("faces", m, tet_path, [](const std::string &off, const std::string &snap, size_t budget) {
+            TetrahedronMesh::collect_faces_out_of_core(off, snap, budget);
+        });
+    }
+
+    std::remove(tri_path.c_str());
+    std::remove(tet_path.c_str());
+    return status;
+}
@@ -0,0 +1,200 @@
+// 高阶自由度编号：在三角形和四面体网格上提取棱表，生成P1、P2、P3的单元 -> 全局自由度表，按线程数测时间，
+// 与用哈希表逐个单元给棱编号的P2比较，并校验：四面体的棱表与std::set的结果相同、满足欧拉公式；
+// 自由度数正确；按局部自由度的位置（顶点、棱的等分点、面或单元的形心）算出的坐标，同一全局自由度在各单元中相同，
+// 不同的全局自由度坐标不同且每个自由度都被用到；结果与线程数无关
+// 用法: bench_dof [四面体网格边长n] [重复次数] [最大线程数]
+
+#include <array>
+#include <cmath>
+#include <set>
+#include <thread>
+#include <unordered_map>
+
+#include "BenchUtils.h"
+#include "mesh_structure/TetrahedronMesh.h"
+#include "mesh_structure/TriangleMesh.h"
+
+using mesh_structure::DofMap;
+using mesh_structure::index_t;
+
+// 单元i的第k个局部自由度的坐标
+template <class T>
+static void local_point(double **xyz, index_t **elem, unsigned long i, int order, int k, double *p) {
+    const int NV = T::nv, NE = T::ne;
+    auto mix = [&](const int *v, const double *w, int n) {
+        for (int d = 0; d < 3; ++d) {
+            p[d] = 0;
+            for (int a = 0; a < n; ++a) p[d] += w[a] * xyz[d][elem[v[a]][i]];
+        }
+    };
+    if (k < NV) {
+        const double w[1] = {1};
+        mix(&k, w, 1);
+    } else if (order == 2) {
+        const double w[2] = {0.5, 0.5};
+        mix(T::edge[k - NV], w, 2);
+    } else if (k < NV + 2 * NE) {
+        const double w[2][2] = {{2.0 / 3, 1.0 / 3}, {1.0 / 3, 2.0 / 3}};
+        mix(T::edge[(k - NV) / 2], w[(k - NV) % 2], 2);
+    } else if (T::dim == 2) {
+        const int v[3] = {0, 1, 2};
+        const double w[3] = {1.0 / 3, 1.0 / 3, 1.0 / 3};
+        mix(v, w, 3);
+    } else {
+        const double w[3] = {1.0 / 3, 1.0 / 3, 1.0 / 3};
+        mix(T::local[k - NV - 2 * NE], w, 3);
+    }
+}
+
+// 同一全局自由度的坐标在各单元中相同、不同自由度的坐标不同、每个自由度都被用到
+template <class T>
+static bool consistent(double **xyz, index_t **elem, const DofMap &map) {
+    std::vector<double> point(3 * map.nDof(), 0);
+    std::vector<unsigned char> seen(map.nDof(), 0);
+    for (unsigned long i = 0; i < map.nElement(); ++i) {
+        for (int k = 0; k < map.nLocal(); ++k) {
+            double p[3];
+            local_point<T>(xyz, elem, i, map.order(), k, p);
+            index_t g = map.element(i)[k];
+            if (g >= map.nDof()) return false;
+            for (int d = 0; d < 3; ++d) {
+                if (seen[g] && std::fabs(point[3 * g + d] - p[d]) > 1e-12) return false;
+                point[3 * g + d] = p[d];
+            }
+            seen[g] = 1;
+        }
+    }
+    std::set<std::array<long long, 3>> distinct;
+    for (unsigned long g = 0; g < map.nDof(); ++g) {
+        if (!seen[g]) return false;
+        std::array<long long, 3> key;
+        for (int d = 0; d < 3; ++d) key[d] = std::llround(point[3 * g + d] * 1e9);
+        distinct.insert(key);
+    }
+    return distinct.size() == map.nDof();
+}
+
+// 对照：逐个单元用哈希表查找棱，第一次出现时编号
+template <class T>
+static unsigned long hash_p2(unsigned long nv, unsigned long ne, index_t **elem, std::vector<index_t> &dof) {
+    const int NV = T::nv, NE = T::ne;
+    std::unordered_map<unsigned long long, index_t> edges;
+    dof.resize((NV + NE) * ne);
+    for (unsigned long i = 0; i < ne; ++i) {
+        index_t *d = dof.data() + (NV + NE) * i;
+        for (int k = 0; k < NV; ++k) d[k] = elem[k][i];
+        for (int k = 0; k < NE; ++k) {
+            index_t a = elem[T::edge[k][0]][i], b = elem[T::edge[k][1]][i];
+            if (b < a) std::swap(a, b);
+            auto it = edges.emplace((static_cast<unsigned long long>(a) << 32) | b, edges.size()).first;
+            d[NV + k] = nv + it->second;
+        }
+    }
+    return nv + edges.size();
+}
+
+template <class T, class M>
+static int run(const char *name, M &m, int repeat, unsigned max_threads) {
+    int status = 0;
+    m.collect_sub_entities();
+    unsigned long nv = m.getNVertex(), ne = m.getNElement(), ns = m.getNSub();
+    index_t **elem = m.element();
+    double *xyz[3] = {m.x_coord(), m.y_coord(), m.z_coord()};
+
+    bench::Timer te;
+    m.collect_mesh_edges();
+    double t_edges = te.seconds();
+    unsigned long nEdge = T::dim == 2 ? ns : m.getNMeshEdge();
+    std::cout << std::fixed << std::setprecision(4) << name << ": " << ne << " elements, " << nEdge << " edges";
+    if (T::dim == 3) std::cout << "   edge table " << t_edges << " s";
+    std::cout << std::endl;
+
+    // 单纯形网格剖分的立方体或正方形，欧拉示性数为1
+    long long euler = T::dim == 2 ? static_cast<long long>(nv) - nEdge + ne
+                                  : static_cast<long long>(nv) - nEdge + ns - ne;
+    if (euler != 1) {
+        std::cout << name << " Euler characteristic is " << euler << "!" << std::endl;
+        status = 1;
+    }
+    if (T::dim == 3) {
+        std::set<std::pair<index_t, index_t>> edges;
+        for (unsigned long i = 0; i < ne; ++i)
+            for (int k = 0; k < T::ne; ++k) {
+                index_t a = elem[T::edge[k][0]][i], b = elem[T::edge[k][1]][i];
+                edges.insert({std::min(a, b), std::max(a, b)});
+            }
+        index_t **edge = m.mesh_edge(), **conn = m.element_edge_connection();
+        bool ok = edges.size() == nEdge;
+        unsigned long e = 0;
+        for (auto it = edges.begin(); ok && it != edges.end(); ++it, ++e)
+            ok = edge[0][e] == it->first && edge[1][e] == it->second;
+        for (unsigned long i = 0; ok && i < ne; ++i)
+            for (int k = 0; k < T::ne; ++k) {
+                index_t a = elem[T::edge[k][0]][i], b = elem[T::edge[k][1]][i];
+                ok = ok && edge[0][conn[k][i]] == std::min(a, b) && edge[1][conn[k][i]] == std::max(a, b);
+            }
+        if (!ok) {
+            std::cout << name << " edge table differs from std::set!" << std::endl;
+            status = 1;
+        }
+    }
+
+    std::vector<index_t> hashed;
+    unsigned long hashed_dof = 0;
+    double t_hash = bench::best_of(repeat, [&] { hashed_dof = hash_p2<T>(nv, ne, elem, hashed); });
+    std::cout << name << " P2 with hash map " << std::setw(8) << t_hash << " s" << std::endl;
+
+    for (int order = 1; order <= 3; ++order) {
+        unsigned long expected = order == 1 ? nv : order == 2 ? nv + nEdge : nv + 2 * nEdge + (T::dim == 2 ? ne : ns);
+        DofMap reference;
+        for (unsigned nt = 1; nt <= max_threads; nt *= 2) {
+            m.setNumThreads(nt);
+            DofMap map;
+            double t = bench::best_of(repeat, [&] { m.dof_map(order, map); });
+            std::cout << name << " P" << order << " x" << std::left << std::setw(4) << nt << std::right
+                      << std::setw(8) << t << " s (" << map.nDof() << " dofs, " << map.nLocal() << " per element)"
+                      << std::endl;
+            if (map.nDof() != expected || (order == 2 && map.nDof() != hashed_dof)) {
+                std::cout << name << " P" << order << " has " << map.nDof() << " dofs, expected " << expected << "!"
+                          << std::endl;
+                status = 1;
+            }
+            if (nt == 1) {
+                if (!consistent<T>(xyz, elem, map)) {
+                    std::cout << name << " P" << order << " numbering is inconsistent between elements!" << std::endl;
+                    status = 1;
+                }
+                reference = std::move(map);
+            } else if (!std::equal(map.dof(), map.dof() + map.nLocal() * ne, reference.dof())) {
+                std::cout << name << " P" << order << " numbering depends on the thread count!" << std::endl;
+                status = 1;
+            }
+        }
+    }
+    return status;
+}
+
+int main(int argc, char **argv) {
+    unsigned long n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20;
+    int repeat = argc > 2 ? std::atoi(argv[2]) : 3;
+    unsigned max_threads = argc > 3 ? std::atoi(argv[3]) : std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+    int status = 0;
+
+    const std::string tri_path = "bench_dof_tri.off", tet_path = "bench_dof_tet.off";
+    bench::GeneratedMesh tri = bench::structured_tri(8 * n), tet = bench::structured_tet(n);
+    bench::shuffle(tri, 12345);
+    bench::shuffle(tet, 12345);
+    bench::write_off(tri_path, tri);
+    bench::write_off(tet_path, tet);
+    TriangleMesh t;
+    t.read_off(tri_path);
+    status |= run<mesh_structure::TriangleTraits>("triangle", t, repeat, max_threads);
+    TetrahedronMesh m;
+    m.read_off(tet_path);
+    status |= run<mesh_structure::TetrahedronTraits>("tetrahedron", m, repeat, max_threads);
+
+    std::remove(tri_path.c_str());
+    std::remove(tet_path.c_str());
+    return status;
+}
@@ -0,0 +1,160 @@
+// 局部编辑：在四面体网格上逐批细分最长边（模拟自适应加密），比较每批局部更新与整体重新提取面的时间，
+// 并校验局部更新后的子实体表与重新提取的结果一致（子实体集合、两侧单元、局部序号、边界列表），总体积不变；
+// 在三角形网格上做随机的边翻转和边收缩，提交时压缩点数组，同样校验，并检查没有孤立点、单元朝向不变
+// 用法: bench_edit [四面体网格边长n] [批数] [每批细分的边数]
+
+#include <array>
+
+#include "BenchUtils.h"
+#include "mesh_structure/TetrahedronMesh.h"
+#include "mesh_structure/TriangleMesh.h"
+
+using mesh_structure::index_t;
+using mesh_structure::local_t;
+
+// 子实体表自身一致，并与重新提取的结果有相同的子实体集合和边界子实体数
+template <class Traits, class M>
+static bool consistent(M &m) {
+    constexpr int NS = Traits::ns, SV = Traits::sv;
+    unsigned long ne = m.getNElement(), ns = m.getNSub(), nb = m.getNBoundary();
+    index_t **elem = m.element(), **sub = m.sub_info(), **conn = m.element_sub_connection();
+    local_t **order = m.sub_order_in_element();
+
+    std::vector<std::array<index_t, SV>> keys(ns), fresh_keys;
+    for (unsigned long s = 0; s < ns; ++s) {
+        for (int a = 0; a < SV; ++a) keys[s][a] = sub[a][s];
+        if (!std::is_sorted(keys[s].begin(), keys[s].end()) || sub[SV][s] >= ne) return false;
+        if (order[0][s] >= NS || conn[order[0][s]][sub[SV][s]] != s) return false;
+        if (sub[SV + 1][s] == ne + 1) {
+            if (order[1][s] != NS) return false;
+        } else if (sub[SV + 1][s] >= ne || order[1][s] >= NS || conn[order[1][s]][sub[SV + 1][s]] != s) {
+            return false;
+        }
+    }
+    for (unsigned long e = 0; e < ne; ++e) {
+        for (int j = 0; j < NS; ++j) {
+            std::array<index_t, SV> key;
+            for (int a = 0; a < SV; ++a) key[a] = elem[Traits::local[j][a]][e];
+            std::sort(key.begin(), key.end());
+            if (conn[j][e] >= ns || keys[conn[j][e]] != key) return false;
+        }
+    }
+    std::vector<index_t> bnd(m.boundary(), m.boundary() + nb);
+    for (index_t s : bnd)
+        if (s >= ns || sub[SV + 1][s] != ne + 1) return false;
+    std::sort(bnd.begin(), bnd.end());
+    if (std::adjacent_find(bnd.begin(), bnd.end()) != bnd.end()) return false;
+
+    M fresh = m.clone();
+    fresh.collect_sub_entities();
+    if (fresh.getNSub() != ns || fresh.getNBoundary() != nb) return false;
+    fresh_keys.resize(ns);
+    for (unsigned long s = 0; s < ns; ++s)
+        for (int a = 0; a < SV; ++a) fresh_keys[s][a] = fresh.sub_info()[a][s];
+    std::sort(keys.begin(), keys.end());
+    std::sort(fresh_keys.begin(), fresh_keys.end());
+    return keys == fresh_keys;
+}
+
+static double length2(TetrahedronMesh &m, index_t a, index_t b) {
+    double dx = m.x_coord()[a] - m.x_coord()[b], dy = m.y_coord()[a] - m.y_coord()[b],
+           dz = m.z_coord()[a] - m.z_coord()[b];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+int main(int argc, char **argv) {
+    unsigned long n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 30;
+    int batches = argc > 2 ? std::atoi(argv[2]) : 5;
+    unsigned long per_batch = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 2000;
+    int status = 0;
+
+    const std::string path = "bench_edit_tet.off";
+    bench::write_structured_tet_off(path, n);
+    TetrahedronMesh m;
+    m.read_off(path);
+    m.fix_orientation();
+    m.begin_edit();
+    std::mt19937_64 rng(42);
+    std::cout << m.getNTetrahedron() << " tetrahedra, " << m.getNFace() << " faces" << std::endl;
+
+    for (int batch = 0; batch < batches; ++batch) {
+        bench::Timer te;
+        for (unsigned long k = 0; k < per_batch; ++k) {
+            index_t e = rng() % m.getNTetrahedron();
+            index_t **tet = m.tetrahedron();
+            index_t a = tet[0][e], b = tet[1][e];
+            for (int i = 0; i < 4; ++i)
+                for (int j = i + 1; j < 4; ++j)
+                    if (length2(m, tet[i][e], tet[j][e]) > length2(m, a, b)) {
+                        a = tet[i][e];
+                        b = tet[j][e];
+                    }
+            m.split_edge(a, b, 0.5 * (m.x_coord()[a] + m.x_coord()[b]), 0.5 * (m.y_coord()[a] + m.y_coord()[b]),
+                         0.5 * (m.z_coord()[a] + m.z_coord()[b]));
+        }
+        m.commit_edits();
+        double t_edit = te.seconds();
+        unsigned long changed = m.changed_elements().size();
+
+        TetrahedronMesh full = m.clone();
+        double t_full = bench::best_of(1, [&] { full.collect_faces(); });
+        std::cout << "batch " << batch << std::fixed << std::setprecision(4) << ": " << m.getNTetrahedron()
+                  << " tetrahedra, " << changed << " changed; local update " << t_edit << " s, full collect "
+                  << t_full << " s" << std::endl;
+
+        if (!consistent<mesh_structure::TetrahedronTraits>(m)) {
+            std::cout << "tetrahedron topology differs from a full collect!" << std::endl;
+            status = 1;
+        }
+        full.compute_geometry();
+        double volume = 0, vmin = 1;
+        for (unsigned long i = 0; i < full.getNTetrahedron(); ++i) {
+            volume += full.tetrahedron_volume()[i];
+            vmin = std::min(vmin, full.tetrahedron_volume()[i]);
+        }
+        if (std::fabs(volume - 1) > 1e-9 || vmin <= 0) {
+            std::cout << "refined volume is wrong: " << volume << std::endl;
+            status = 1;
+        }
+    }
+    m.end_edit();
+    std::remove(path.c_str());
+
+    // 三角形网格：随机翻转边、收缩边，提交时压缩
+    const std::string tri_path = "bench_edit_tri.off";
+    bench::write_structured_tri_off(tri_path, 60);
+    TriangleMesh t;
+    t.read_off(tri_path);
+    t.begin_edit();
+    unsigned long flipped = 0, collapsed = 0;
+    for (int k = 0; k < 5000; ++k)
+        flipped += t.flip_sub(rng() % t.getNEdge());
+    // 只把内部点合并到相邻点，区域的形状不变
+    for (int k = 0; k < 1500; ++k) {
+        index_t s = rng() % t.getNEdge(), a = t.edge_info()[0][s], b = t.edge_info()[1][s];
+        double bx = t.x_coord()[b], by = t.y_coord()[b];
+        if (bx > 0 && bx < 1 && by > 0 && by < 1) collapsed += t.collapse_edge(a, b);
+    }
+    t.commit_edits(true);
+    std::cout << "triangles: " << flipped << " flips, " << collapsed << " collapses, " << t.getNVertex()
+              << " vertices, " << t.getNTriangle() << " triangles left" << std::endl;
+
+    std::vector<unsigned long> used(t.getNVertex(), 0);
+    for (int j = 0; j < 3; ++j)
+        for (unsigned long i = 0; i < t.getNTriangle(); ++i) ++used[t.triangle()[j][i]];
+    if (std::count(used.begin(), used.end(), 0UL) != 0 || !consistent<mesh_structure::TriangleTraits>(t) ||
+        flipped == 0 || collapsed == 0) {
+        std::cout << "triangle topology after flips and collapses is inconsistent!" << std::endl;
+        status = 1;
+    }
+    t.end_edit();
+    t.compute_geometry();
+    double area = 0;
+    for (unsigned long i = 0; i < t.getNTriangle(); ++i) area += t.triangle_area()[i] * t.triangle_normal()[2][i];
+    if (std::fabs(area - 1) > 1e-9) {
+        std::cout << "signed area changed: " << area << std::endl;
+        status = 1;
+    }
+    std::remove(tri_path.c_str());
+    return status;
+}
@@ -0,0 +1,141 @@
+// 子实体循环：在三角形（边）和四面体（面）网格上做一次有限体积式的通量累加，按线程数比较
+// 串行循环、按颜色并行的for_each_sub和按单元并行的for_each_element_sub，
+// 并校验：着色有效（同色子实体没有公共单元，边界子实体在末尾）、三种方式的结果相同
+// 用法: bench_face_loop [四面体网格边长n] [重复次数] [最大线程数]
+
+#include <thread>
+
+#include "BenchUtils.h"
+#include "mesh_structure/TetrahedronMesh.h"
+#include "mesh_structure/TriangleMesh.h"
+
+using mesh_structure::index_t;
+
+template <class M>
+static bool check_coloring(M &m) {
+    mesh_structure::CsrView colors = m.sub_coloring();
+    unsigned long ne = m.getNElement(), nb = m.getNBoundary();
+    index_t **sub = m.sub_info();
+    const int SV = M::SV;
+    if (colors.nnz() != m.getNSub()) return false;
+    std::vector<unsigned long> stamp(ne + 2, ~0ul), seen(m.getNSub(), 0);
+    for (unsigned long c = 0; c < colors.nRow(); ++c) {
+        for (index_t s : colors[c]) {
+            bool inner = sub[SV + 1][s] != ne + 1;
+            // 内部子实体在前，边界子实体占末尾的nBoundary个
+            if (inner != (c < m.getNInteriorColor()) || inner != (colors.offset()[c] < colors.nnz() - nb)) return false;
+            for (int a = 0; a < (inner ? 2 : 1); ++a) {
+                if (stamp[sub[SV + a][s]] == c) return false;
+                stamp[sub[SV + a][s]] = c;
+            }
+            ++seen[s];
+        }
+    }
+    for (unsigned long s = 0; s < m.getNSub(); ++s)
+        if (seen[s] != 1) return false;
+    return true;
+}
+
+// 通量：两侧单元值之差除以形心间的距离，边界上取单元自身的值
+template <class M>
+static int run(const char *name, M &m, int repeat, unsigned max_threads) {
+    int status = 0;
+    m.collect_sub_entities();
+    m.compute_geometry();
+    m.build_sub_coloring();
+    std::cout << name << ": " << m.getNElement() << " elements, " << m.getNSub() << " sub-entities, "
+              << m.getNInteriorColor() << " interior + " << m.getNColor() - m.getNInteriorColor() << " boundary colors"
+              << std::endl;
+    if (!check_coloring(m)) {
+        std::cout << name << " coloring is invalid!" << std::endl;
+        status = 1;
+    }
+
+    unsigned long ne = m.getNElement(), ns = m.getNSub();
+    double **c = m.element_centroid();
+    std::vector<double> u(ne), inv_dist(ns, 0);
+    for (unsigned long i = 0; i < ne; ++i) u[i] = std::sin(3 * c[0][i]) + c[1][i] * c[2][i];
+    index_t **sub = m.sub_info();
+    for (unsigned long s = 0; s < ns; ++s) {
+        index_t l = sub[M::SV][s], r = sub[M::SV + 1][s];
+        if (r == ne + 1) continue;
+        double d2 = 0;
+        for (int d = 0; d < 3; ++d) d2 += (c[d][l] - c[d][r]) * (c[d][l] - c[d][r]);
+        inv_dist[s] = 1 / std::sqrt(d2);
+    }
+
+    std::vector<double> serial(ne), colored(ne), owner(ne);
+    auto flux = [&](index_t s, index_t l, index_t r) { return (u[l] - u[r]) * inv_dist[s]; };
+    auto run_serial = [&] {
+        std::fill(serial.begin(), serial.end(), 0.0);
+        for (unsigned long s = 0; s < ns; ++s) {
+            index_t l = sub[M::SV][s], r = sub[M::SV + 1][s];
+            if (r == ne + 1) {
+                serial[l] -= u[l];
+            } else {
+                double f = flux(s, l, r);
+                serial[l] -= f;
+                serial[r] += f;
+            }
+        }
+    };
+    auto run_colored = [&] {
+        std::fill(colored.begin(), colored.end(), 0.0);
+        m.for_each_sub([&](index_t s, index_t l, index_t r) {
+            double f = flux(s, l, r);
+            colored[l] -= f;
+            colored[r] += f;
+        }, [&](index_t, index_t l) { colored[l] -= u[l]; });
+    };
+    auto run_owner = [&] {
+        std::fill(owner.begin(), owner.end(), 0.0);
+        m.for_each_element_sub([&](index_t i, int, index_t s, index_t other) {
+            owner[i] -= other == ne + 1 ? u[i] : flux(s, i, other);
+        });
+    };
+
+    for (unsigned nt = 1; nt <= max_threads; nt *= 2) {
+        m.setNumThreads(nt);
+        double t_serial = bench::best_of(repeat, run_serial);
+        double t_colored = bench::best_of(repeat, run_colored);
+        double t_owner = bench::best_of(repeat, run_owner);
+        std::cout << name << " x" << std::left << std::setw(4) << nt << std::right << std::fixed << std::setprecision(4)
+                  << " serial " << std::setw(8) << t_serial << " s   colored " << std::setw(8) << t_colored
+                  << " s   owner-computes " << std::setw(8) << t_owner << " s" << std::endl;
+        double err = 0, scale = 0;
+        for (unsigned long i = 0; i < ne; ++i) {
+            err = std::max(err, std::max(std::fabs(colored[i] - serial[i]), std::fabs(owner[i] - serial[i])));
+            scale = std::max(scale, std::fabs(serial[i]));
+        }
+        if (err > 1e-9 * (scale + 1)) {
+            std::cout << name << " parallel loops disagree with the serial loop!" << std::endl;
+            status = 1;
+        }
+    }
+    return status;
+}
+
+int main(int argc, char **argv) {
+    unsigned long n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 40;
+    int repeat = argc > 2 ? std::atoi(argv[2]) : 3;
+    unsigned max_threads = argc > 3 ? std::atoi(argv[3]) : std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+    int status = 0;
+
+    const std::string tri_path = "bench_face_loop_tri.off", tet_path = "bench_face_loop_tet.off";
+    bench::GeneratedMesh tri = bench::structured_tri(16 * n), tet = bench::structured_tet(n);
+    bench::shuffle(tri, 12345);
+    bench::shuffle(tet, 12345);
+    bench::write_off(tri_path, tri);
+    bench::write_off(tet_path, tet);
+    TriangleMesh t;
+    t.read_off(tri_path);
+    status |= run("triangle", t, repeat, max_threads);
+    TetrahedronMesh m;
+    m.read_off(tet_path);
+    status |= run("tetrahedron", m, repeat, max_threads);
+
+    std::remove(tri_path.c_str());
+    std::remove(tet_path.c_str());
+    return status;
+}
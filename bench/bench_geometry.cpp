@@ -0,0 +1,85 @@
+// 比较几何核函数在各指令集下的速度，并检查结果与标量实现一致
+// 用法: bench_geometry [四面体网格边长n] [重复次数] [线程数]
+
+#include <cmath>
+
+#include "BenchUtils.h"
+#include "mesh_structure/GeometryKernels.h"
+#include "mesh_structure/TetrahedronMesh.h"
+
+using mesh_structure::SimdLevel;
+
+struct Geometry {
+    std::vector<double> vol, cen[3], nrm[3], area;
+};
+
+static double max_diff(const std::vector<double> &a, const std::vector<double> &b) {
+    double d = 0;
+    for (size_t i = 0; i < a.size(); ++i) d = std::max(d, std::fabs(a[i] - b[i]));
+    return d;
+}
+
+int main(int argc, char **argv) {
+    unsigned long n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 60;
+    int repeat = argc > 2 ? std::atoi(argv[2]) : 5;
+    unsigned nthreads = argc > 3 ? std::atoi(argv[3]) : 1;
+
+    const std::string path = "bench_geometry_tet.off";
+    bench::GeneratedMesh g = bench::structured_tet(n);
+    bench::shuffle(g, 4321);
+    bench::write_off(path, g);
+    TetrahedronMesh m;
+    m.read_off(path);
+    std::remove(path.c_str());
+    m.reorder(mesh_structure::ReorderMethod::Morton, nullptr, nullptr);
+    m.collect_faces();
+
+    const unsigned long ne = m.getNTetrahedron(), nf = m.getNFace();
+    const double *x = m.x_coord(), *y = m.y_coord(), *z = m.z_coord();
+    mesh_structure::index_t **tet = m.tetrahedron(), **face = m.face_info();
+    std::cout << "tetrahedra " << ne << ", faces " << nf << ", threads " << nthreads << ", cpu max "
+              << mesh_structure::simd_level_name(mesh_structure::max_simd_level()) << std::endl;
+
+    Geometry ref;
+    const SimdLevel levels[3] = {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512};
+    for (SimdLevel level : levels) {
+        if (static_cast<int>(level) > static_cast<int>(mesh_structure::max_simd_level())) break;
+        mesh_structure::set_simd_level(level);
+        Geometry r;
+        r.vol.resize(ne);
+        r.area.resize(nf);
+        for (int d = 0; d < 3; ++d) {
+            r.cen[d].resize(ne);
+            r.nrm[d].resize(nf);
+        }
+        double *cen[3] = {r.cen[0].data(), r.cen[1].data(), r.cen[2].data()};
+        double *nrm[3] = {r.nrm[0].data(), r.nrm[1].data(), r.nrm[2].data()};
+
+        double tv = bench::best_of(repeat, [&] {
+            mesh_structure::tetrahedron_volumes(ne, x, y, z, tet, r.vol.data(), nthreads);
+        });
+        double tc = bench::best_of(repeat, [&] {
+            mesh_structure::element_centroids(ne, 4, x, y, z, tet, cen, nthreads);
+        });
+        double tf = bench::best_of(repeat, [&] {
+            mesh_structure::face_normals(nf, x, y, z, face, face[3], cen, nrm, r.area.data(), nthreads);
+        });
+        std::cout << std::left << std::setw(8) << mesh_structure::simd_level_name(level) << std::right
+                  << std::fixed << std::setprecision(2)
+                  << "  volume " << std::setw(8) << ne / tv / 1e6 << " Melem/s"
+                  << "  centroid " << std::setw(8) << ne / tc / 1e6 << " Melem/s"
+                  << "  face normal " << std::setw(8) << nf / tf / 1e6 << " Mface/s" << std::endl;
+
+        if (level == SimdLevel::Scalar) {
+            ref = r;
+            continue;
+        }
+        double err = max_diff(r.vol, ref.vol) + max_diff(r.area, ref.area);
+        for (int d = 0; d < 3; ++d) err += max_diff(r.cen[d], ref.cen[d]) + max_diff(r.nrm[d], ref.nrm[d]);
+        if (err > 1e-12) {
+            std::cerr << "result differs from scalar kernels by " << err << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+// 基于BVH的点定位、最近单元和k近邻查询：按线程数测吞吐量，并在抽样的查询上与暴力搜索比较
+// 用法: bench_locate [四面体网格边长n] [查询点数] [k] [最大线程数]
+
+#include <thread>
+
+#include "BenchUtils.h"
+#include "mesh_structure/SpatialIndex.h"
+#include "mesh_structure/TetrahedronMesh.h"
+#include "mesh_structure/TriangleMesh.h"
+
+using mesh_structure::index_t;
+
+static void report(const char *name, double seconds, unsigned long nquery) {
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(4)
+              << std::setw(10) << seconds << " s" << std::setprecision(2) << std::setw(10)
+              << nquery / seconds / 1e6 << " Mquery/s" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    unsigned long n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 40;
+    unsigned long nq = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2000000;
+    unsigned long k = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 8;
+    unsigned max_threads = argc > 4 ? std::atoi(argv[4]) : std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+    int status = 0;
+
+    const std::string path = "bench_locate_tet.off";
+    bench::GeneratedMesh g = bench::structured_tet(n);
+    bench::shuffle(g, 12345);
+    bench::write_off(path, g);
+    TetrahedronMesh m;
+    m.read_off(path);
+    unsigned long ne = m.getNTetrahedron(), nv = m.getNVertex();
+    double *x = m.x_coord(), *y = m.y_coord(), *z = m.z_coord();
+    index_t **tet = m.tetrahedron();
+
+    // 查询点：大部分在单位立方体内，少量在外面
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> u(-0.05, 1.05);
+    std::vector<double> px(nq), py(nq), pz(nq);
+    for (unsigned long q = 0; q < nq; ++q) {
+        px[q] = u(rng);
+        py[q] = u(rng);
+        pz[q] = u(rng);
+    }
+
+    mesh_structure::ElementLocator<mesh_structure::TetrahedronTraits> locator;
+    mesh_structure::VertexSearch search;
+    bench::Timer tb;
+    locator.build(ne, x, y, z, tet);
+    double t_elem = tb.seconds();
+    bench::Timer tv;
+    search.build(nv, x, y, z);
+    double t_vert = tv.seconds();
+    std::cout << ne << " tetrahedra, " << nq << " queries; build element BVH " << std::setprecision(4) << t_elem
+              << " s, vertex BVH " << t_vert << " s" << std::endl;
+
+    std::vector<index_t> found(nq), near(nq), knn(nq * k);
+    std::vector<double> bary[4], dist2(nq), kd(nq * k);
+    for (int j = 0; j < 4; ++j) bary[j].resize(nq);
+    double *b[4] = {bary[0].data(), bary[1].data(), bary[2].data(), bary[3].data()};
+    for (unsigned nt = 1; nt <= max_threads; nt *= 2) {
+        std::string s = " x" + std::to_string(nt);
+        bench::Timer t1;
+        locator.locate(nq, px.data(), py.data(), pz.data(), found.data(), b, nt);
+        report(("locate" + s).c_str(), t1.seconds(), nq);
+        bench::Timer t2;
+        locator.nearest(nq, px.data(), py.data(), pz.data(), near.data(), nullptr, dist2.data(), nt);
+        report(("nearest element" + s).c_str(), t2.seconds(), nq);
+        bench::Timer t3;
+        search.nearest(nq, px.data(), py.data(), pz.data(), k, knn.data(), kd.data(), nt);
+        report(("nearest " + std::to_string(k) + " vertices" + s).c_str(), t3.seconds(), nq);
+    }
+
+    // 与暴力搜索比较：定位到的单元用重心坐标还原查询点；立方体外的点必须找不到；k近邻的距离必须一致
+    for (unsigned long q = 0; q < nq; q += nq / 200 + 1) {
+        double p[3] = {px[q], py[q], pz[q]};
+        bool inside = p[0] >= 0 && p[0] <= 1 && p[1] >= 0 && p[1] <= 1 && p[2] >= 0 && p[2] <= 1;
+        if (found[q] > ne) {
+            if (inside) status = 1;
+            for (int j = 0; j < 4; ++j)
+                if (!std::isnan(bary[j][q])) status = 1;
+        } else {
+            double r[3] = {0, 0, 0}, sum = 0, minb = 1;
+            for (int j = 0; j < 4; ++j) {
+                index_t v = tet[j][found[q]];
+                r[0] += bary[j][q] * x[v];
+                r[1] += bary[j][q] * y[v];
+                r[2] += bary[j][q] * z[v];
+                sum += bary[j][q];
+                minb = std::min(minb, bary[j][q]);
+            }
+            double err = std::fabs(r[0] - p[0]) + std::fabs(r[1] - p[1]) + std::fabs(r[2] - p[2]) + std::fabs(sum - 1);
+            if (!inside || err > 1e-9 || minb < -1e-9)
+                status = 1;
+        }
+        // 点到单位立方体的距离即为到网格的距离
+        double e2 = 0;
+        for (int d = 0; d < 3; ++d) {
+            double e = std::max(std::max(-p[d], p[d] - 1), 0.0);
+            e2 += e * e;
+        }
+        if (std::fabs(dist2[q] - e2) > 1e-12) status = 1;
+
+        std::vector<double> all(nv);
+        for (unsigned long v = 0; v < nv; ++v)
+            all[v] = (x[v] - p[0]) * (x[v] - p[0]) + (y[v] - p[1]) * (y[v] - p[1]) + (z[v] - p[2]) * (z[v] - p[2]);
+        std::partial_sort(all.begin(), all.begin() + k, all.end());
+        for (unsigned long j = 0; j < k; ++j)
+            if (all[j] != kd[q * k + j]) status = 1;
+    }
+    if (status != 0) std::cout << "tetrahedron queries differ from brute force!" << std::endl;
+
+    // 空的定位结构：批量最近单元全部找不到，重心坐标为NaN，距离的平方为1e300
+    {
+        mesh_structure::ElementLocator<mesh_structure::TetrahedronTraits> empty;
+        empty.build(0, x, y, z, tet);
+        index_t e[2];
+        double eb[4][2], *ebp[4] = {eb[0], eb[1], eb[2], eb[3]}, ed[2];
+        empty.nearest(2, px.data(), py.data(), pz.data(), e, ebp, ed, 1);
+        for (int q = 0; q < 2; ++q) {
+            bool ok = e[q] == 1 && ed[q] == 1e300;
+            for (int j = 0; j < 4; ++j) ok = ok && std::isnan(eb[j][q]);
+            if (!ok) {
+                std::cout << "empty locator returned uninitialized results!" << std::endl;
+                status = 1;
+            }
+        }
+    }
+
+    // 三角形曲面：抬高的点的最近单元距离为抬高量，投影点应定位在同一个三角形上
+    {
+        const std::string tri_path = "bench_locate_tri.off";
+        bench::write_off(tri_path, bench::structured_tri(200));
+        TriangleMesh t;
+        t.read_off(tri_path);
+        mesh_structure::ElementLocator<mesh_structure::TriangleTraits> tl;
+        tl.build(t.getNTriangle(), t.x_coord(), t.y_coord(), t.z_coord(), t.triangle());
+        for (unsigned long q = 0; q < 1000; ++q) {
+            double p[3] = {px[q], py[q], 0.25}, bt[3], d2 = 0;
+            unsigned long e = tl.nearest(p, bt, &d2);
+            double ex = std::max(std::max(-p[0], p[0] - 1), 0.0), ey = std::max(std::max(-p[1], p[1] - 1), 0.0);
+            if (e >= t.getNTriangle() || std::fabs(d2 - (ex * ex + ey * ey + 0.0625)) > 1e-12) status = 2;
+            p[2] = 0;
+            unsigned long e0 = tl.locate(p, bt);
+            if ((ex == 0 && ey == 0) != (e0 < t.getNTriangle())) status = 2;
+        }
+        if (status == 2) std::cout << "triangle queries differ from expected distances!" << std::endl;
+        std::remove(tri_path.c_str());
+    }
+
+    std::remove(path.c_str());
+    return status;
+}
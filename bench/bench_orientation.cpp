@@ -0,0 +1,148 @@
+// 单元朝向：按线程数测fix_orientation的时间，并校验：
+//   四面体网格翻转一组已知的单元后，返回值等于翻转的个数，之后体积全部为正，再次调用返回0
+//   封闭的三角形曲面（立方体四面体网格的边界）翻转一部分面后，法向量全部朝外
+//   xy平面上的开曲面，输入为顺时针（夹杂少量逆时针）时，结果全部为逆时针
+// 用法: bench_orientation [四面体网格边长n] [重复次数] [最大线程数]
+
+#include <thread>
+
+#include "BenchUtils.h"
+#include "mesh_structure/TetrahedronMesh.h"
+#include "mesh_structure/TriangleMesh.h"
+
+using mesh_structure::index_t;
+
+// 交换单元i的第1、2个顶点，使朝向相反
+static void flip(index_t **elem, unsigned long i) {
+    std::swap(elem[1][i], elem[2][i]);
+}
+
+// 用给定的坐标和单元（每个单元三个顶点，按单元交错存放）建立三角形网格，flipped中的单元反向
+static void build(TriangleMesh &s, const double *const *xyz, unsigned long nv, const std::vector<index_t> &tri,
+                  const std::vector<unsigned char> &flipped) {
+    unsigned long nt = tri.size() / 3;
+    s.allocate(nv, nt);
+    for (unsigned long v = 0; v < nv; ++v) {
+        s.x_coord()[v] = xyz[0][v];
+        s.y_coord()[v] = xyz[1][v];
+        s.z_coord()[v] = xyz[2][v];
+    }
+    for (unsigned long t = 0; t < nt; ++t) {
+        for (int a = 0; a < 3; ++a) s.triangle()[a][t] = tri[3 * t + a];
+        if (flipped[t]) flip(s.triangle(), t);
+    }
+}
+
+int main(int argc, char **argv) {
+    unsigned long n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 30;
+    int repeat = argc > 2 ? std::atoi(argv[2]) : 3;
+    unsigned max_threads = argc > 3 ? std::atoi(argv[3]) : std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+    int status = 0;
+
+    const std::string path = "bench_orientation_tet.off";
+    bench::GeneratedMesh g = bench::structured_tet(n);
+    bench::shuffle(g, 12345);
+    bench::write_off(path, g);
+
+    // 四面体：先统一朝向，再翻转每7个中的一个
+    TetrahedronMesh m;
+    m.read_off(path);
+    m.fix_orientation();
+    unsigned long ne = m.getNTetrahedron(), reflected = 0;
+    for (unsigned long i = 0; i < ne; i += 7, ++reflected) flip(m.tetrahedron(), i);
+    TetrahedronMesh base = m.clone();
+    for (unsigned nt = 1; nt <= max_threads; nt *= 2) {
+        unsigned long flipped = 0;
+        double t = bench::best_of(repeat, [&] {
+            m.clone_from(base);
+            m.setNumThreads(nt);
+            flipped = m.fix_orientation();
+        });
+        unsigned long again = m.fix_orientation();
+        m.compute_geometry();
+        bool positive = true;
+        for (unsigned long i = 0; i < ne; ++i) positive = positive && m.tetrahedron_volume()[i] > 0;
+        std::cout << "tetrahedron x" << std::left << std::setw(4) << nt << std::right << std::fixed
+                  << std::setprecision(4) << std::setw(8) << t << " s (" << flipped << " of " << ne
+                  << " flipped)" << std::endl;
+        if (flipped != reflected || again != 0 || !positive) {
+            std::cout << "tetrahedron orientation: flipped " << flipped << ", expected " << reflected
+                      << ", second call " << again << (positive ? "" : ", non-positive volumes") << "!" << std::endl;
+            status = 1;
+        }
+    }
+
+    // 封闭曲面：边界曲面的法向量朝外，翻转每5个中的一个后应恢复
+    {
+        TriangleMesh surf, s;
+        mesh_structure::SurfaceMap map;
+        m.extract_boundary(surf, map);
+        unsigned long ntri = surf.getNTriangle();
+        std::vector<index_t> tri(3 * ntri);
+        std::vector<unsigned char> flipped(ntri, 0);
+        unsigned long expected = 0;
+        for (unsigned long i = 0; i < ntri; ++i) {
+            for (int a = 0; a < 3; ++a) tri[3 * i + a] = surf.triangle()[a][i];
+            flipped[i] = i % 5 == 2;
+            expected += flipped[i];
+        }
+        double *xyz[3] = {surf.x_coord(), surf.y_coord(), surf.z_coord()};
+        for (unsigned nt = 1; nt <= max_threads; nt *= 2) {
+            build(s, xyz, surf.getNVertex(), tri, flipped);
+            s.setNumThreads(nt);
+            unsigned long count = s.fix_orientation();
+            s.compute_geometry();
+            bool outward = true;
+            for (unsigned long i = 0; i < ntri; ++i) {
+                double out = 0;
+                for (int d = 0; d < 3; ++d) out += s.triangle_normal()[d][i] * (s.triangle_centroid()[d][i] - 0.5);
+                outward = outward && out > 0;
+            }
+            std::cout << "closed surface x" << nt << ": " << count << " of " << ntri << " flipped" << std::endl;
+            if (count != expected || !outward) {
+                std::cout << "closed surface normals do not all point outward!" << std::endl;
+                status = 1;
+            }
+        }
+    }
+
+    // 开曲面：structured_tri为逆时针，全部反向后再把每9个中的一个改回逆时针
+    {
+        bench::GeneratedMesh p = bench::structured_tri(8 * n);
+        bench::shuffle(p, 12345);
+        unsigned long nv = p.nVertex(), ntri = p.nElement();
+        std::vector<double> coord(3 * nv);
+        for (unsigned long v = 0; v < nv; ++v)
+            for (int d = 0; d < 3; ++d) coord[d * nv + v] = p.xyz[3 * v + d];
+        double *xyz[3] = {coord.data(), coord.data() + nv, coord.data() + 2 * nv};
+        std::vector<index_t> tri(p.elem.begin(), p.elem.end());
+        std::vector<unsigned char> flipped(ntri);
+        unsigned long expected = 0;
+        for (unsigned long i = 0; i < ntri; ++i) {
+            flipped[i] = i % 9 != 4;
+            expected += flipped[i];
+        }
+        TriangleMesh s;
+        for (unsigned nt = 1; nt <= max_threads; nt *= 2) {
+            build(s, xyz, nv, tri, flipped);
+            s.setNumThreads(nt);
+            unsigned long count = s.fix_orientation();
+            bool ccw = true;
+            for (unsigned long i = 0; i < ntri; ++i) {
+                index_t a = s.triangle()[0][i], b = s.triangle()[1][i], c = s.triangle()[2][i];
+                double area = (xyz[0][b] - xyz[0][a]) * (xyz[1][c] - xyz[1][a]) -
+                              (xyz[1][b] - xyz[1][a]) * (xyz[0][c] - xyz[0][a]);
+                ccw = ccw && area > 0;
+            }
+            std::cout << "open surface x" << nt << ": " << count << " of " << ntri << " flipped" << std::endl;
+            if (count != expected || !ccw) {
+                std::cout << "open planar surface is not counter-clockwise!" << std::endl;
+                status = 1;
+            }
+        }
+    }
+
+    std::remove(path.c_str());
+    return status;
+}
@@ -0,0 +1,117 @@
+// 四面体网格的递归坐标二分分区和子网格生成（含一层幽灵单元），按线程数测时间，
+// 并校验：每个单元恰好属于一个部分、各部分单元数均衡、子网格的编号映射与全局网格一致、交界面两侧成对出现、
+// 写出的分区文件能原样读回
+// 用法: bench_partition [网格边长n] [部分数] [重复次数] [最大线程数]
+
+#include <thread>
+
+#include "BenchUtils.h"
+#include "mesh_structure/TetrahedronMesh.h"
+
+using mesh_structure::index_t;
+using mesh_structure::PartMap;
+
+static bool check(TetrahedronMesh &m, const std::vector<index_t> &part, unsigned long nParts,
+                  std::vector<TetrahedronMesh> &subs, const std::vector<PartMap> &maps, unsigned long cut) {
+    unsigned long ne = m.getNTetrahedron();
+    std::vector<unsigned long> owner_count(ne, 0);
+    unsigned long nInterface = 0, lo = ne, hi = 0;
+    index_t **tet = m.tetrahedron();
+    index_t **face = m.face_info();
+    double *x = m.x_coord();
+    for (unsigned long p = 0; p < nParts; ++p) {
+        TetrahedronMesh &s = subs[p];
+        const PartMap &map = maps[p];
+        lo = std::min(lo, map.nOwned);
+        hi = std::max(hi, map.nOwned);
+        nInterface += map.interface.size();
+        if (s.getNTetrahedron() != map.element_global.size() || s.getNVertex() != map.vertex_global.size() ||
+            s.getNFace() != map.sub_global.size() || map.ghost_owner.size() != map.element_global.size() - map.nOwned)
+            return false;
+        for (unsigned long k = 0; k < map.element_global.size(); ++k) {
+            index_t e = map.element_global[k];
+            if (k < map.nOwned) {
+                if (part[e] != p) return false;
+                ++owner_count[e];
+            } else if (part[e] != map.ghost_owner[k - map.nOwned] || part[e] == p) {
+                return false;
+            }
+            for (int j = 0; j < 4; ++j)
+                if (map.vertex_global[s.tetrahedron()[j][k]] != tet[j][e]) return false;
+        }
+        for (unsigned long v = 0; v < s.getNVertex(); ++v)
+            if (s.x_coord()[v] != x[map.vertex_global[v]] || map.vertex_owner[v] >= nParts) return false;
+        for (unsigned long f = 0; f < s.getNFace(); ++f) {
+            index_t g = map.sub_global[f];
+            for (int a = 0; a < 3; ++a)
+                if (map.vertex_global[s.face_info()[a][f]] != face[a][g]) return false;
+        }
+        for (index_t f : map.interface) {
+            index_t g = map.sub_global[f];
+            if (face[4][g] >= ne || part[face[3][g]] == part[face[4][g]]) return false;
+        }
+    }
+    for (unsigned long e = 0; e < ne; ++e)
+        if (owner_count[e] != 1) return false;
+    // 每个交界面在两侧的部分中各出现一次；单元数按部分数均分，相差不超过1
+    return nInterface == 2 * cut && hi - lo <= 1;
+}
+
+int main(int argc, char **argv) {
+    unsigned long n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 40;
+    unsigned long nParts = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 12;
+    int repeat = argc > 3 ? std::atoi(argv[3]) : 3;
+    unsigned max_threads = argc > 4 ? std::atoi(argv[4]) : std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+    int status = 0;
+
+    const std::string path = "bench_partition_tet.off";
+    bench::GeneratedMesh g = bench::structured_tet(n);
+    bench::shuffle(g, 12345);
+    bench::write_off(path, g);
+
+    TetrahedronMesh m;
+    m.read_off(path);
+    m.collect_faces();
+    unsigned long ne = m.getNTetrahedron();
+    std::vector<index_t> part(ne);
+    std::vector<TetrahedronMesh> subs;
+    std::vector<PartMap> maps;
+    std::cout << ne << " tetrahedra, " << nParts << " parts" << std::endl;
+
+    for (unsigned nt = 1; nt <= max_threads; nt *= 2) {
+        m.setNumThreads(nt);
+        unsigned long cut = 0;
+        double tp = bench::best_of(repeat, [&] { cut = m.partition(nParts, part.data()); });
+        double te = bench::best_of(repeat, [&] { m.extract_parts(part.data(), nParts, subs, maps); });
+        unsigned long nGhost = 0;
+        for (const PartMap &map : maps) nGhost += map.element_global.size() - map.nOwned;
+        std::cout << "x" << std::left << std::setw(4) << nt << std::right << std::fixed << std::setprecision(4)
+                  << " partition " << std::setw(8) << tp << " s   extract " << std::setw(8) << te << " s   cut faces "
+                  << cut << "   ghosts " << nGhost << std::endl;
+        if (!check(m, part, nParts, subs, maps, cut)) {
+            std::cout << "partition result is inconsistent!" << std::endl;
+            status = 1;
+        }
+    }
+
+    TetrahedronMesh::write_parts("bench_partition", subs, maps);
+    for (unsigned long p = 0; p < nParts; ++p) {
+        std::string base = "bench_partition." + std::to_string(p);
+        TetrahedronMesh s;
+        PartMap map;
+        s.read_snapshot(base + ".snap");
+        mesh_structure::read_part_map(base + ".map", map);
+        if (s.getNFace() != subs[p].getNFace() || map.nOwned != maps[p].nOwned ||
+            map.element_global != maps[p].element_global || map.interface != maps[p].interface ||
+            map.sub_global != maps[p].sub_global) {
+            std::cout << "partition files differ after reading back!" << std::endl;
+            status = 1;
+        }
+        std::remove((base + ".snap").c_str());
+        std::remove((base + ".map").c_str());
+    }
+
+    std::remove(path.c_str());
+    return status;
+}
@@ -0,0 +1,184 @@
+// 比较内存映射OFF读取器与原getline/splitOff/stoi读取器的吞吐量
+// 并给出多线程读取随线程数的伸缩性；校验每个线程数下读入的坐标和单元与原读取器的完全相同，
+// 另读入一个含CRLF行尾、#注释行和空行的文件（大于分块下限，块边界落在这些行中），与生成的网格比较
+// 用法: bench_read_off [三角形网格边长n] [四面体网格边长n] [重复次数] [最大线程数]
+
+#include <thread>
+
+#include "BenchUtils.h"
+#include "mesh_structure/TriangleMesh.h"
+#include "mesh_structure/TetrahedronMesh.h"
+
+namespace legacy {
+
+// 原实现：逐行getline，trim/splitOff构造临时字符串，再stoi/stod
+std::string trim(std::string s) {
+    if (s.empty()) return s;
+    s.erase(0, s.find_first_not_of(" \t\r\n"));
+    s.erase(s.find_last_not_of(" \t\r\n") + 1);
+    return s;
+}
+
+bool splitOff(const std::string &str, const std::string &pattern, int npattern, std::string *res) {
+    std::string text = trim(str);
+    if (str.empty()) return false;
+    std::string strs = text + pattern;
+    size_t pos = strs.find(pattern);
+    int n = 0;
+    while (pos != std::string::npos) {
+        std::string temp = strs.substr(0, pos);
+        res[n++] = temp;
+        strs = strs.substr(pos + 1, strs.size());
+        pos = strs.find(pattern);
+        if (n >= npattern) break;
+    }
+    return true;
+}
+
+void read_off(const std::string &path, int nv, std::vector<double> &xyz, std::vector<unsigned long> &elem) {
+    std::fstream file(path, std::ios::in);
+    std::string line;
+    getline(file, line);
+    getline(file, line);
+    std::string first_line[4];
+    unsigned long nVertex = 0, nElement = 0;
+    if (splitOff(line, " ", 2, first_line)) {
+        nVertex = stoi(first_line[0]);
+        nElement = stoi(first_line[1]);
+    }
+    xyz.resize(3 * nVertex);
+    elem.resize(nv * nElement);
+    std::string data[5];
+    for (unsigned long i = 0; i < nVertex; ++i) {
+        getline(file, line);
+        if (splitOff(line, " ", 3, data)) {
+            xyz[3 * i] = stod(data[0]);
+            xyz[3 * i + 1] = stod(data[1]);
+            xyz[3 * i + 2] = stod(data[2]);
+        }
+    }
+    for (unsigned long i = 0; i < nElement; ++i) {
+        getline(file, line);
+        if (splitOff(line, " ", nv + 1, data)) {
+            for (int j = 0; j < nv; ++j) elem[nv * i + j] = stoi(data[j + 1]);
+        }
+    }
+}
+
+}  // namespace legacy
+
+// 读入的网格与按点、按单元交错存放的坐标和单元逐个相同
+template <class M>
+static bool same(M &m, const std::vector<double> &xyz, const std::vector<unsigned long> &elem) {
+    const int nv = M::NV;
+    if (m.getNVertex() * 3 != xyz.size() || m.getNElement() * nv != elem.size()) return false;
+    const double *c[3] = {m.x_coord(), m.y_coord(), m.z_coord()};
+    for (unsigned long i = 0; i < m.getNVertex(); ++i)
+        for (int d = 0; d < 3; ++d)
+            if (c[d][i] != xyz[3 * i + d]) return false;
+    for (unsigned long i = 0; i < m.getNElement(); ++i)
+        for (int j = 0; j < nv; ++j)
+            if (m.element()[j][i] != elem[nv * i + j]) return false;
+    return true;
+}
+
+// 与write_off相同的内容，但行尾为CRLF，每隔几行插入#注释行或空行，个别行带行尾空白
+static void write_messy_off(const std::string &path, const bench::GeneratedMesh &m) {
+    FILE *f = std::fopen(path.c_str(), "wb");
+    std::fprintf(f, "OFF\r\n# generated by bench_read_off\r\n\r\n%lu %lu 0\r\n", m.nVertex(), m.nElement());
+    unsigned long line = 0;
+    auto filler = [&] {
+        ++line;
+        if (line % 7 == 0) std::fprintf(f, "# comment line %lu with numbers 1 2 3\r\n", line);
+        else if (line % 11 == 0) std::fprintf(f, "\r\n");
+        else if (line % 13 == 0) std::fprintf(f, "   \t\r\n");
+    };
+    for (unsigned long i = 0; i < m.nVertex(); ++i) {
+        filler();
+        std::fprintf(f, "%.17g %.17g %.17g%s\r\n", m.xyz[3 * i], m.xyz[3 * i + 1], m.xyz[3 * i + 2],
+                     i % 5 == 0 ? "  " : "");
+    }
+    for (unsigned long i = 0; i < m.nElement(); ++i) {
+        filler();
+        std::fprintf(f, "%d", m.nv);
+        for (int j = 0; j < m.nv; ++j) std::fprintf(f, " %lu", m.elem[m.nv * i + j]);
+        std::fprintf(f, "\r\n");
+    }
+    std::fclose(f);
+}
+
+static void report(const char *name, double seconds, long bytes, unsigned long nelem) {
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(4)
+              << std::setw(10) << seconds << " s" << std::setprecision(1) << std::setw(10)
+              << bytes / seconds / 1e6 << " MB/s" << std::setw(14) << nelem / seconds / 1e6 << " Melem/s"
+              << std::endl;
+}
+
+int main(int argc, char **argv) {
+    unsigned long ntri = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 500;
+    unsigned long ntet = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 40;
+    int repeat = argc > 3 ? std::atoi(argv[3]) : 3;
+    unsigned max_threads = argc > 4 ? std::atoi(argv[4]) : std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+    int status = 0;
+
+    const std::string tri_path = "bench_read_off_tri.off";
+    const std::string tet_path = "bench_read_off_tet.off";
+    bench::write_structured_tri_off(tri_path, ntri);
+    bench::write_structured_tet_off(tet_path, ntet);
+    long tri_bytes = bench::file_size(tri_path), tet_bytes = bench::file_size(tet_path);
+
+    unsigned long nelem = 0;
+    std::vector<double> xyz;
+    std::vector<unsigned long> elem;
+
+    double t = bench::best_of(repeat, [&] { legacy::read_off(tri_path, 3, xyz, elem); });
+    nelem = elem.size() / 3;
+    report("triangle legacy", t, tri_bytes, nelem);
+    for (unsigned nt = 1; nt <= max_threads; nt *= 2) {
+        TriangleMesh m;
+        m.setNumThreads(nt);
+        t = bench::best_of(repeat, [&] { m.read_off(tri_path); });
+        report(("triangle mmap x" + std::to_string(nt)).c_str(), t, tri_bytes, nelem);
+        if (!same(m, xyz, elem)) {
+            std::cout << "triangle mesh differs from the legacy reader (x" << nt << ")!" << std::endl;
+            status = 1;
+        }
+    }
+
+    t = bench::best_of(repeat, [&] { legacy::read_off(tet_path, 4, xyz, elem); });
+    nelem = elem.size() / 4;
+    report("tetrahedron legacy", t, tet_bytes, nelem);
+    for (unsigned nt = 1; nt <= max_threads; nt *= 2) {
+        TetrahedronMesh m;
+        m.setNumThreads(nt);
+        t = bench::best_of(repeat, [&] { m.read_off(tet_path); });
+        report(("tetrahedron mmap x" + std::to_string(nt)).c_str(), t, tet_bytes, nelem);
+        if (!same(m, xyz, elem)) {
+            std::cout << "tetrahedron mesh differs from the legacy reader (x" << nt << ")!" << std::endl;
+            status = 1;
+        }
+    }
+
+    // 含注释、空行和CRLF的文件约7MB，分块读入时（至少用到4个线程）块边界落在各种行中
+    const std::string messy_path = "bench_read_off_messy.off";
+    bench::GeneratedMesh g = bench::structured_tet(30);
+    bench::shuffle(g, 12345);
+    write_messy_off(messy_path, g);
+    for (unsigned nt = 1; nt <= std::max(max_threads, 8u); nt *= 2) {
+        TetrahedronMesh m;
+        m.setNumThreads(nt);
+        m.read_off(messy_path);
+        if (!same(m, g.xyz, g.elem)) {
+            std::cout << "mesh with comments, blank lines and CRLF read wrongly (x" << nt << ")!" << std::endl;
+            status = 1;
+        }
+    }
+    std::cout << "comments, blank lines and CRLF (" << bench::file_size(messy_path) / 1048576.0 << " MB) "
+              << (status == 0 ? "read correctly" : "FAILED") << std::endl;
+
+    std::remove(tri_path.c_str());
+    std::remove(tet_path.c_str());
+    std::remove(messy_path.c_str());
+    return status;
+}
@@ -0,0 +1,133 @@
+// 一致加密：逐级加密三角形和四面体网格，按线程数比较refine_uniform与对细网格整体重新提取子实体的时间，
+// 并校验：子实体表自身一致且与重新提取的结果相同、面积/体积不变且单元朝向不变、父单元和中点的映射正确
+// 用法: bench_refine [四面体网格边长n] [级数] [最大线程数]
+
+#include <array>
+#include <thread>
+
+#include "BenchUtils.h"
+#include "mesh_structure/TetrahedronMesh.h"
+#include "mesh_structure/TriangleMesh.h"
+
+using mesh_structure::index_t;
+using mesh_structure::local_t;
+
+template <class Traits, class M>
+static bool check(M &coarse, M &fine, const std::vector<index_t> &element_parent,
+                  const std::vector<index_t> &vertex_parent) {
+    constexpr int NS = Traits::ns, SV = Traits::sv;
+    unsigned long ne = fine.getNElement(), ns = fine.getNSub(), nb = fine.getNBoundary(), nv = fine.getNVertex();
+    index_t **elem = fine.element(), **sub = fine.sub_info(), **conn = fine.element_sub_connection();
+    local_t **order = fine.sub_order_in_element();
+
+    std::vector<std::array<index_t, SV>> keys(ns), fresh_keys(ns);
+    for (unsigned long s = 0; s < ns; ++s) {
+        for (int a = 0; a < SV; ++a) keys[s][a] = sub[a][s];
+        if (!std::is_sorted(keys[s].begin(), keys[s].end()) || sub[SV][s] >= ne) return false;
+        if (order[0][s] >= NS || conn[order[0][s]][sub[SV][s]] != s) return false;
+        if (sub[SV + 1][s] == ne + 1) {
+            if (order[1][s] != NS) return false;
+        } else if (sub[SV + 1][s] >= ne || order[1][s] >= NS || conn[order[1][s]][sub[SV + 1][s]] != s) {
+            return false;
+        }
+    }
+    for (unsigned long e = 0; e < ne; ++e) {
+        for (int j = 0; j < NS; ++j) {
+            std::array<index_t, SV> key;
+            for (int a = 0; a < SV; ++a) key[a] = elem[Traits::local[j][a]][e];
+            std::sort(key.begin(), key.end());
+            if (conn[j][e] >= ns || keys[conn[j][e]] != key) return false;
+        }
+        if (element_parent[e] != e / (1u << Traits::dim)) return false;
+    }
+    for (unsigned long b = 0; b < nb; ++b)
+        if (sub[SV + 1][fine.boundary()[b]] != ne + 1) return false;
+    for (unsigned long v = 0; v < nv; ++v) {
+        index_t a = vertex_parent[2 * v], b = vertex_parent[2 * v + 1];
+        double x = 0.5 * (coarse.x_coord()[a] + coarse.x_coord()[b]);
+        if ((v < coarse.getNVertex()) != (a == b && a == v) || fine.x_coord()[v] != x) return false;
+    }
+
+    M fresh = fine.clone();
+    fresh.collect_sub_entities();
+    if (fresh.getNSub() != ns || fresh.getNBoundary() != nb) return false;
+    for (unsigned long s = 0; s < ns; ++s)
+        for (int a = 0; a < SV; ++a) fresh_keys[s][a] = fresh.sub_info()[a][s];
+    std::sort(keys.begin(), keys.end());
+    std::sort(fresh_keys.begin(), fresh_keys.end());
+    if (keys != fresh_keys) return false;
+
+    // 加密前后面积或体积相同，每个子单元的朝向与父单元相同
+    coarse.compute_geometry();
+    fine.compute_geometry();
+    double *cm = coarse.element_measure(), *fm = fine.element_measure();
+    double total = 0, fine_total = 0;
+    for (unsigned long e = 0; e < coarse.getNElement(); ++e) total += cm[e];
+    for (unsigned long e = 0; e < ne; ++e) {
+        fine_total += fm[e];
+        if (Traits::dim == 3 && fm[e] * cm[element_parent[e]] <= 0) return false;
+        if (Traits::dim == 2) {
+            double dot = 0;
+            for (int d = 0; d < 3; ++d)
+                dot += fine.element_normal()[d][e] * coarse.element_normal()[d][element_parent[e]];
+            if (dot <= 0) return false;
+        }
+    }
+    return std::fabs(total - fine_total) < 1e-9 * std::fabs(total);
+}
+
+template <class Traits, class M>
+static int run(const char *name, M &m, int levels, unsigned max_threads) {
+    int status = 0;
+    m.collect_sub_entities();
+    for (int level = 0; level < levels; ++level) {
+        M fine;
+        std::vector<index_t> element_parent, vertex_parent;
+        for (unsigned nt = 1; nt <= max_threads; nt *= 2) {
+            m.setNumThreads(nt);
+            bench::Timer tr;
+            m.refine_uniform(fine);
+            double t_refine = tr.seconds();
+            M full = fine.clone();
+            full.setNumThreads(nt);
+            bench::Timer tc;
+            full.collect_sub_entities();
+            double t_collect = tc.seconds();
+            std::cout << name << " level " << level + 1 << " x" << std::left << std::setw(4) << nt << std::right
+                      << std::fixed << std::setprecision(4) << fine.getNElement() << " elements   refine "
+                      << std::setw(8) << t_refine << " s   collect " << std::setw(8) << t_collect << " s" << std::endl;
+        }
+        element_parent.resize(fine.getNElement());
+        vertex_parent.resize(2 * fine.getNVertex());
+        m.refine_uniform(fine, element_parent.data(), vertex_parent.data());
+        if (!check<Traits>(m, fine, element_parent, vertex_parent)) {
+            std::cout << name << " refinement is inconsistent!" << std::endl;
+            status = 1;
+        }
+        m = std::move(fine);
+    }
+    return status;
+}
+
+int main(int argc, char **argv) {
+    unsigned long n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 16;
+    int levels = argc > 2 ? std::atoi(argv[2]) : 2;
+    unsigned max_threads = argc > 3 ? std::atoi(argv[3]) : std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+    int status = 0;
+
+    const std::string tri_path = "bench_refine_tri.off", tet_path = "bench_refine_tet.off";
+    bench::write_structured_tri_off(tri_path, 8 * n);
+    bench::write_structured_tet_off(tet_path, n);
+    TriangleMesh t;
+    t.read_off(tri_path);
+    status |= run<mesh_structure::TriangleTraits>("triangle", t, levels, max_threads);
+    TetrahedronMesh m;
+    m.read_off(tet_path);
+    m.fix_orientation();
+    status |= run<mesh_structure::TetrahedronTraits>("tetrahedron", m, levels, max_threads);
+
+    std::remove(tri_path.c_str());
+    std::remove(tet_path.c_str());
+    return status;
+}
@@ -0,0 +1,132 @@
+// 比较网格重排前后按单元收集点坐标（计算形心）的有效带宽
+// 输入网格的点和单元编号被随机打乱，模拟局部性差的网格生成器
+// 并按线程数校验：重排前已提取面、构建邻接并计算几何量，重排后各perm为双射，重排后的子实体表、
+// 单元-子实体关系、序号和边界列表与在重排后的网格上重新提取的完全相同，总体积不变
+// 用法: bench_reorder [四面体网格边长n] [重复次数] [最大线程数]
+
+#include <cmath>
+#include <thread>
+
+#include "BenchUtils.h"
+#include "mesh_structure/TetrahedronMesh.h"
+
+// 每个单元读取4个顶点编号和12个坐标，写出3个形心坐标
+static double gather(TetrahedronMesh &m, std::vector<double> &c) {
+    unsigned long n = m.getNTetrahedron();
+    mesh_structure::index_t **tet = m.tetrahedron();
+    const double *x = m.x_coord(), *y = m.y_coord(), *z = m.z_coord();
+    c.resize(3 * n);
+    for (unsigned long i = 0; i < n; ++i) {
+        double sx = 0, sy = 0, sz = 0;
+        for (int j = 0; j < 4; ++j) {
+            unsigned long v = tet[j][i];
+            sx += x[v];
+            sy += y[v];
+            sz += z[v];
+        }
+        c[3 * i] = 0.25 * sx;
+        c[3 * i + 1] = 0.25 * sy;
+        c[3 * i + 2] = 0.25 * sz;
+    }
+    return c[0];
+}
+
+static bool bijection(const std::vector<unsigned long> &perm) {
+    std::vector<unsigned char> seen(perm.size(), 0);
+    for (unsigned long p : perm) {
+        if (p >= perm.size() || seen[p]) return false;
+        seen[p] = 1;
+    }
+    return true;
+}
+
+static double total_volume(TetrahedronMesh &m) {
+    double v = 0;
+    for (unsigned long i = 0; i < m.getNTetrahedron(); ++i) v += std::fabs(m.tetrahedron_volume()[i]);
+    return v;
+}
+
+// 重排后置换得到的拓扑与重新提取的相同
+static bool same_topology(TetrahedronMesh &a, TetrahedronMesh &b) {
+    unsigned long ne = a.getNTetrahedron(), nf = a.getNFace();
+    if (nf != b.getNFace() || a.getNBoundary() != b.getNBoundary()) return false;
+    for (int k = 0; k < 5; ++k)
+        if (!std::equal(a.face_info()[k], a.face_info()[k] + nf, b.face_info()[k])) return false;
+    for (int k = 0; k < 4; ++k)
+        if (!std::equal(a.tet_face_connection()[k], a.tet_face_connection()[k] + ne, b.tet_face_connection()[k]))
+            return false;
+    for (int k = 0; k < 2; ++k)
+        if (!std::equal(a.face_order_in_tet()[k], a.face_order_in_tet()[k] + nf, b.face_order_in_tet()[k]))
+            return false;
+    return std::equal(a.boundary(), a.boundary() + a.getNBoundary(), b.boundary());
+}
+
+static void report(const char *name, double seconds, unsigned long nelem) {
+    double bytes = nelem * (4.0 * 8 + 12.0 * 8 + 3.0 * 8);
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(4)
+              << std::setw(10) << seconds << " s" << std::setprecision(2) << std::setw(10)
+              << bytes / seconds / 1e9 << " GB/s" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    unsigned long n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 60;
+    int repeat = argc > 2 ? std::atoi(argv[2]) : 5;
+    unsigned max_threads = argc > 3 ? std::atoi(argv[3]) : std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+    int status = 0;
+
+    const std::string path = "bench_reorder_tet.off";
+    bench::GeneratedMesh g = bench::structured_tet(n);
+    bench::shuffle(g, 12345);
+    bench::write_off(path, g);
+
+    std::vector<double> c;
+    const char *names[2] = {"morton", "rcm"};
+    const mesh_structure::ReorderMethod methods[2] = {mesh_structure::ReorderMethod::Morton,
+                                                      mesh_structure::ReorderMethod::RCM};
+    for (int k = 0; k < 2; ++k) {
+        TetrahedronMesh m;
+        m.read_off(path);
+        unsigned long ne = m.getNTetrahedron();
+        if (k == 0) report("gather shuffled", bench::best_of(repeat, [&] { gather(m, c); }), ne);
+        bench::Timer t;
+        m.reorder(methods[k], nullptr, nullptr);
+        double treorder = t.seconds();
+        report((std::string("gather ") + names[k]).c_str(), bench::best_of(repeat, [&] { gather(m, c); }), ne);
+        std::cout << "  reorder time " << std::setprecision(4) << treorder << " s" << std::endl;
+    }
+
+    // 已提取面、构建邻接并计算几何量时重排，拓扑由permute_topology置换而不是重新提取
+    for (int k = 0; k < 2; ++k) {
+        for (unsigned nt = 1; nt <= std::max(max_threads, 4u); nt *= 2) {
+            TetrahedronMesh m;
+            m.setNumThreads(nt);
+            m.read_off(path);
+            m.collect_faces();
+            m.build_adjacency();
+            m.compute_geometry();
+            double volume = total_volume(m);
+            std::vector<unsigned long> vperm(m.getNVertex()), eperm(m.getNTetrahedron()), sperm(m.getNFace());
+            m.reorder(methods[k], vperm.data(), eperm.data(), sperm.data());
+
+            TetrahedronMesh fresh = m.clone();
+            fresh.collect_faces();
+            bool ok = bijection(vperm) && bijection(eperm) && bijection(sperm);
+            if (!ok) std::cout << names[k] << " x" << nt << ": permutations are not bijections!" << std::endl;
+            if (!same_topology(m, fresh)) {
+                std::cout << names[k] << " x" << nt << ": permuted faces differ from a fresh collect_faces!"
+                          << std::endl;
+                ok = false;
+            }
+            if (std::fabs(total_volume(m) - volume) > 1e-12 * volume) {
+                std::cout << names[k] << " x" << nt << ": total volume changed!" << std::endl;
+                ok = false;
+            }
+            if (!ok) status = 1;
+        }
+    }
+    if (status == 0) std::cout << "reordered topology matches a fresh extraction" << std::endl;
+
+    std::remove(path.c_str());
+    return status;
+}
@@ -0,0 +1,122 @@
+// 稀疏矩阵结构：在三角形和四面体网格上生成点-点和单元-单元的CSR结构，按线程数测时间，与用std::set逐行收集比较，
+// 并校验：结构与std::set的结果相同、行内升序且含对角元；用散布表组装后，点-点矩阵的每个元素等于包含这两个点的单元数，
+// 单元-单元矩阵（每个子实体贡献[1 -1; -1 1]，边界子实体贡献1）的对角元为每个单元的子实体数、非对角元为-1
+// 用法: bench_sparsity [四面体网格边长n] [重复次数] [最大线程数]
+
+#include <set>
+#include <thread>
+
+#include "BenchUtils.h"
+#include "mesh_structure/TetrahedronMesh.h"
+#include "mesh_structure/TriangleMesh.h"
+
+using mesh_structure::index_t;
+using mesh_structure::SparsityPattern;
+
+static bool same_pattern(const SparsityPattern &p, const std::vector<std::set<index_t>> &rows) {
+    if (p.nRow() != rows.size()) return false;
+    for (unsigned long i = 0; i < rows.size(); ++i) {
+        mesh_structure::IndexSpan row = p.view()[i];
+        if (row.size() != rows[i].size() || !std::equal(row.begin(), row.end(), rows[i].begin())) return false;
+    }
+    return true;
+}
+
+template <class M>
+static int run(const char *name, M &m, int repeat, unsigned max_threads) {
+    const int NV = M::NV, NS = M::NS, SV = M::SV;
+    int status = 0;
+    m.collect_sub_entities();
+    unsigned long nv = m.getNVertex(), ne = m.getNElement(), ns = m.getNSub();
+    index_t **elem = m.element(), **sub = m.sub_info();
+
+    std::vector<std::set<index_t>> vrows, erows;
+    bench::Timer ts;
+    vrows.assign(nv, {});
+    for (unsigned long i = 0; i < ne; ++i)
+        for (int a = 0; a < NV; ++a)
+            for (int b = 0; b < NV; ++b) vrows[elem[a][i]].insert(elem[b][i]);
+    erows.assign(ne, {});
+    for (unsigned long i = 0; i < ne; ++i) erows[i].insert(i);
+    for (unsigned long s = 0; s < ns; ++s) {
+        index_t l = sub[SV][s], r = sub[SV + 1][s];
+        if (r == ne + 1) continue;
+        erows[l].insert(r);
+        erows[r].insert(l);
+    }
+    std::cout << name << ": " << ne << " elements   std::set " << std::fixed << std::setprecision(4) << ts.seconds()
+              << " s" << std::endl;
+
+    SparsityPattern vp, ep;
+    for (unsigned nt = 1; nt <= max_threads; nt *= 2) {
+        m.setNumThreads(nt);
+        double t_vertex = bench::best_of(repeat, [&] { m.vertex_pattern(vp); });
+        double t_element = bench::best_of(repeat, [&] { m.element_pattern(ep); });
+        std::cout << name << " x" << std::left << std::setw(4) << nt << std::right << " vertex " << std::setw(8)
+                  << t_vertex << " s (" << vp.nnz() << " nnz)   element " << std::setw(8) << t_element << " s ("
+                  << ep.nnz() << " nnz)" << std::endl;
+        if (!same_pattern(vp, vrows) || !same_pattern(ep, erows)) {
+            std::cout << name << " sparsity pattern differs from std::set!" << std::endl;
+            status = 1;
+        }
+    }
+
+    // 用散布表组装，与逐个(行, 列)计数的结果比较
+    std::vector<double> vvalues(vp.nnz(), 0), evalues(ep.nnz(), 0);
+    bench::Timer ta;
+    for (unsigned long i = 0; i < ne; ++i) {
+        const unsigned long *slot = vp.slot() + NV * NV * i;
+        for (int k = 0; k < NV * NV; ++k) vvalues[slot[k]] += 1;
+    }
+    double t_assemble = ta.seconds();
+    for (unsigned long s = 0; s < ns; ++s) {
+        const unsigned long *slot = ep.slot() + 4 * s;
+        evalues[slot[0]] += 1;
+        if (sub[SV + 1][s] == ne + 1) {
+            if (slot[1] != mesh_structure::pattern_none) status = 1;
+            continue;
+        }
+        evalues[slot[1]] -= 1;
+        evalues[slot[2]] -= 1;
+        evalues[slot[3]] += 1;
+    }
+    std::cout << name << " assembly through slots " << t_assemble << " s" << std::endl;
+    std::vector<double> count(vp.nnz(), 0);
+    for (unsigned long i = 0; i < ne; ++i)
+        for (int a = 0; a < NV; ++a)
+            for (int b = 0; b < NV; ++b) count[vp.find(elem[a][i], elem[b][i])] += 1;
+    bool ok = status == 0 && vvalues == count;
+    for (unsigned long i = 0; i < ne && ok; ++i)
+        for (unsigned long k = ep.offset()[i]; k < ep.offset()[i + 1]; ++k)
+            ok = ok && evalues[k] == (ep.column()[k] == i ? NS : -1);
+    if (!ok) {
+        std::cout << name << " assembly through slots is wrong!" << std::endl;
+        status = 1;
+    }
+    return status;
+}
+
+int main(int argc, char **argv) {
+    unsigned long n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 30;
+    int repeat = argc > 2 ? std::atoi(argv[2]) : 3;
+    unsigned max_threads = argc > 3 ? std::atoi(argv[3]) : std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+    int status = 0;
+
+    const std::string tri_path = "bench_sparsity_tri.off", tet_path = "bench_sparsity_tet.off";
+    bench::GeneratedMesh tri = bench::structured_tri(8 * n), tet = bench::structured_tet(n);
+    bench::shuffle(tri, 12345);
+    bench::shuffle(tet, 12345);
+    bench::write_off(tri_path, tri);
+    bench::write_off(tet_path, tet);
+    TriangleMesh t;
+    t.read_off(tri_path);
+    status |= run("triangle", t, repeat, max_threads);
+    TetrahedronMesh m;
+    m.read_off(tet_path);
+    status |= run("tetrahedron", m, repeat, max_threads);
+
+    std::remove(tri_path.c_str());
+    std::remove(tet_path.c_str());
+    return status;
+}
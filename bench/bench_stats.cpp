@@ -0,0 +1,124 @@
+// 性能统计与错误报告：在四面体网格上开启统计，依次读入、提取面、构建邻接、计算几何量、重排、输出，
+// 打印各阶段的调用次数、耗时和存储区峰值增量并写为JSON，比较开启与关闭统计时提取面的耗时；
+// 再把OFF文件的某一行改坏，按线程数读入，校验抛出的ParseError给出的行号
+// 用法: bench_stats [网格边长n] [重复次数] [最大线程数] [JSON输出文件]
+
+#include <thread>
+
+#include "BenchUtils.h"
+#include "mesh_structure/TetrahedronMesh.h"
+
+using mesh_structure::MeshStats;
+using mesh_structure::ParseError;
+using mesh_structure::PhaseStats;
+
+static std::vector<std::string> read_lines(const std::string &path) {
+    std::ifstream f(path);
+    std::vector<std::string> lines;
+    for (std::string s; std::getline(f, s);) lines.push_back(s);
+    return lines;
+}
+
+static void write_lines(const std::string &path, const std::vector<std::string> &lines) {
+    std::ofstream f(path);
+    for (const std::string &s : lines) f << s << '\n';
+}
+
+// 读入改坏的文件，返回ParseError给出的行号，没有报错时返回0
+static unsigned long error_line(const std::string &path, unsigned nt) {
+    TetrahedronMesh m;
+    m.setNumThreads(nt);
+    try {
+        m.read_off(path);
+    } catch (const ParseError &e) {
+        return e.line();
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    unsigned long n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 40;
+    int repeat = argc > 2 ? std::atoi(argv[2]) : 3;
+    unsigned max_threads = argc > 3 ? std::atoi(argv[3]) : std::thread::hardware_concurrency();
+    std::string json = argc > 4 ? argv[4] : "bench_stats.json";
+    if (max_threads == 0) max_threads = 1;
+    int status = 0;
+
+    const std::string path = "bench_stats_tet.off", bad = "bench_stats_bad.off", plt = "bench_stats_tet.plt";
+    bench::GeneratedMesh g = bench::structured_tet(n);
+    bench::shuffle(g, 12345);
+    bench::write_off(path, g);
+
+    TetrahedronMesh m;
+    m.setNumThreads(max_threads);
+    m.enable_stats();
+    m.read_off(path);
+    m.collect_faces();
+    m.build_adjacency();
+    m.compute_geometry();
+    m.reorder(mesh_structure::ReorderMethod::Morton, nullptr, nullptr);
+    m.outputTecPlotDataFile(plt.c_str());
+
+    const MeshStats &stats = *m.stats();
+    std::cout << std::left << std::setw(22) << "phase" << std::right << std::setw(6) << "calls" << std::setw(12)
+              << "seconds" << std::setw(14) << "peak MB" << std::setw(14) << "net MB" << std::endl;
+    for (const PhaseStats &p : stats.phases())
+        std::cout << std::left << std::setw(22) << p.name << std::right << std::setw(6) << p.calls << std::fixed
+                  << std::setprecision(4) << std::setw(12) << p.seconds << std::setprecision(2) << std::setw(14)
+                  << p.peak_bytes / 1048576.0 << std::setw(14) << p.net_bytes / 1048576.0 << std::endl;
+    stats.write_json(json);
+    std::cout << "stats written to " << json << std::endl;
+
+    // 重排时重新计算邻接和几何量，这两个阶段各调用两次
+    const char *once[] = {"read_off", "collect_sub_entities", "reorder", "outputTecPlotDataFile"};
+    for (const char *name : once) {
+        const PhaseStats *p = stats.find(name);
+        if (p == nullptr || p->calls != 1) status = 1;
+    }
+    const PhaseStats *collect = stats.find("collect_sub_entities"), *adjacency = stats.find("build_adjacency");
+    if (collect == nullptr || collect->net_bytes <= 0 ||
+        static_cast<long long>(collect->peak_bytes) < collect->net_bytes || adjacency == nullptr || adjacency->calls != 2 || stats.find("compute_geometry")->calls != 2)
+        status = 1;
+    if (status != 0) std::cout << "phase statistics are inconsistent!" << std::endl;
+
+    m.reset_stats();
+    double t_on = bench::best_of(repeat, [&] { m.collect_faces(); });
+    m.enable_stats(false);
+    double t_off = bench::best_of(repeat, [&] { m.collect_faces(); });
+    std::cout << "collect_faces with stats " << std::setprecision(4) << t_on << " s, without " << t_off << " s"
+              << std::endl;
+
+    // 行号从1开始：第1行为OFF，第2行为个数，点v在第3+v行，单元i在第3+nVertex+i行
+    std::vector<std::string> lines = read_lines(path);
+    unsigned long nv = g.nVertex(), ne = g.nElement();
+    struct Case {
+        const char *what;
+        unsigned long line;
+        std::string text;
+    } cases[] = {
+        {"vertex coordinate", 3 + nv / 3, "0.5 abc 0.5"},
+        {"element size", 3 + nv + ne / 2, "3 0 1 2"},
+        {"vertex index", 3 + nv + ne - 1, "4 0 1 2 " + std::to_string(nv)},
+        {"end of file", lines.size() - 1, ""},
+    };
+    for (const Case &c : cases) {
+        std::vector<std::string> broken = lines;
+        if (c.text.empty()) broken.pop_back();
+        else broken[c.line - 1] = c.text;
+        write_lines(bad, broken);
+        for (unsigned nt = 1; nt <= std::max(max_threads, 4u); nt *= 2) {
+            unsigned long line = error_line(bad, nt);
+            if (line != c.line) {
+                std::cout << c.what << " error reported on line " << line << ", expected " << c.line << " (x" << nt
+                          << ")" << std::endl;
+                status = 1;
+            }
+        }
+    }
+    if (status == 0) std::cout << "parse errors report the right line numbers" << std::endl;
+
+    std::remove(path.c_str());
+    std::remove(bad.c_str());
+    std::remove(plt.c_str());
+    return status;
+}
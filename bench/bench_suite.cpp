@@ -0,0 +1,127 @@
+// 基准测试套件：生成结构化（可加随机扰动）的三角形和四面体网格，按线程数测读入（read_off或直接生成）、
+// 提取边/面、构建邻接关系和输出Tecplot文件的时间、吞吐量（单元/秒）和峰值常驻内存，
+// 结果另写为JSON，便于在不同版本之间比较
+// 用法: bench_suite [--mesh tri|tet|all] [--elements 单元数] [--jitter 扰动] [--input off|memory]
+//                   [--threads 最大线程数] [--repeat 重复次数] [--json 输出文件，-为标准输出]
+
+#include <sstream>
+#include <thread>
+
+#include "BenchUtils.h"
+#include "mesh_structure/TetrahedronMesh.h"
+#include "mesh_structure/TriangleMesh.h"
+
+struct Options {
+    std::string mesh = "all";
+    unsigned long elements = 1000000;
+    double jitter = 0.1;
+    std::string input = "off";
+    unsigned threads = std::thread::hardware_concurrency();
+    int repeat = 3;
+    std::string json = "bench_suite.json";
+};
+
+struct Record {
+    std::string mesh, op;
+    unsigned long nVertex, nElement;
+    unsigned threads;
+    double seconds;
+    long peak_rss_kb;
+};
+
+static Options parse(int argc, char **argv) {
+    Options o;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i], value = argv[i + 1];
+        if (key == "--mesh") o.mesh = value;
+        else if (key == "--elements") o.elements = std::strtoul(value.c_str(), nullptr, 10);
+        else if (key == "--jitter") o.jitter = std::atof(value.c_str());
+        else if (key == "--input") o.input = value;
+        else if (key == "--threads") o.threads = std::atoi(value.c_str());
+        else if (key == "--repeat") o.repeat = std::atoi(value.c_str());
+        else if (key == "--json") o.json = value;
+        else std::cerr << "unknown option " << key << std::endl;
+    }
+    if (o.threads == 0) o.threads = 1;
+    if (o.repeat < 1) o.repeat = 1;
+    return o;
+}
+
+// JSON写到标准输出时，表格改写到标准错误
+static std::ostream *table = &std::cout;
+
+// 每步之前重置峰值内存，记录最短时间和这一步的内存峰值
+template <class F>
+static void measure(std::vector<Record> &out, const std::string &mesh, const std::string &op, unsigned nt,
+                    int repeat, F &&f, unsigned long nVertex, unsigned long nElement) {
+    bench::reset_peak_rss();
+    double t = bench::best_of(repeat, f);
+    Record r{mesh, op, nVertex, nElement, nt, t, bench::peak_rss_kb()};
+    *table << std::left << std::setw(4) << mesh << std::setw(14) << op << std::right << " x" << std::setw(3) << nt
+              << std::fixed << std::setprecision(4) << std::setw(10) << t << " s" << std::setprecision(2)
+              << std::setw(10) << nElement / t / 1e6 << " Melem/s" << std::setw(10) << r.peak_rss_kb / 1024.0
+              << " MB" << std::endl;
+    out.push_back(r);
+}
+
+template <class M>
+static void run(const Options &o, int nv, const std::string &name, std::vector<Record> &records) {
+    bench::StructuredGenerator g = bench::StructuredGenerator::with_elements(nv, o.elements, o.jitter);
+    const std::string off = "bench_suite_" + name + ".off", plt = "bench_suite_" + name + ".plt";
+    if (o.input == "off") bench::write_off(off, g);
+    unsigned long ne = g.nElement(), nvert = g.nVertex();
+
+    M m;
+    for (unsigned nt = 1; nt <= o.threads; nt *= 2) {
+        m.setNumThreads(nt);
+        if (o.input == "off")
+            measure(records, name, "read_off", nt, o.repeat, [&] { m.read_off(off); }, nvert, ne);
+        else
+            measure(records, name, "generate", nt, o.repeat, [&] { bench::fill_mesh(m, g, nt); }, nvert, ne);
+        measure(records, name, nv == 3 ? "collect_edges" : "collect_faces", nt, o.repeat,
+                [&] { m.collect_sub_entities(); }, nvert, ne);
+        measure(records, name, "adjacency", nt, o.repeat, [&] { m.build_adjacency(); }, nvert, ne);
+        measure(records, name, "tecplot", nt, 1, [&] { m.outputTecPlotDataFile(plt.c_str()); }, nvert, ne);
+    }
+    std::remove(off.c_str());
+    std::remove(plt.c_str());
+}
+
+static std::string to_json(const Options &o, const std::vector<Record> &records) {
+    std::ostringstream s;
+    s << "{\n  \"input\": \"" << o.input << "\",\n  \"jitter\": " << o.jitter << ",\n  \"index_bits\": "
+      << 8 * sizeof(mesh_structure::index_t) << ",\n  \"hardware_threads\": " << std::thread::hardware_concurrency()
+      << ",\n  \"results\": [\n";
+    for (size_t k = 0; k < records.size(); ++k) {
+        const Record &r = records[k];
+        s << "    {\"mesh\": \"" << r.mesh << "\", \"op\": \"" << r.op << "\", \"vertices\": " << r.nVertex
+          << ", \"elements\": " << r.nElement << ", \"threads\": " << r.threads << ", \"seconds\": "
+          << std::setprecision(6) << r.seconds << ", \"elements_per_second\": " << std::setprecision(6)
+          << r.nElement / r.seconds << ", \"peak_rss_kb\": " << r.peak_rss_kb << "}"
+          << (k + 1 < records.size() ? ",\n" : "\n");
+    }
+    s << "  ]\n}\n";
+    return s.str();
+}
+
+int main(int argc, char **argv) {
+    Options o = parse(argc, argv);
+    if (o.input != "off" && o.input != "memory") {
+        std::cerr << "--input must be off or memory" << std::endl;
+        return 1;
+    }
+    if (o.json == "-") table = &std::cerr;
+    std::vector<Record> records;
+    if (o.mesh == "tri" || o.mesh == "all") run<TriangleMesh>(o, 3, "tri", records);
+    if (o.mesh == "tet" || o.mesh == "all") run<TetrahedronMesh>(o, 4, "tet", records);
+
+    std::string json = to_json(o, records);
+    if (o.json == "-") {
+        std::cout << json;
+    } else {
+        std::ofstream f(o.json);
+        f << json;
+        std::cout << "results written to " << o.json << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+// 边界曲面提取：单位立方体的四面体网格取出三角形边界曲面，按线程数测时间，
+// 并校验：曲面封闭且欧拉示性数为2、法向量全部朝外、总面积为6、按30度特征角分为6个面片、映射与体网格一致
+// 用法: bench_surface [网格边长n] [重复次数] [最大线程数]
+
+#include <thread>
+
+#include "BenchUtils.h"
+#include "mesh_structure/TetrahedronMesh.h"
+#include "mesh_structure/TriangleMesh.h"
+
+using mesh_structure::index_t;
+using mesh_structure::SurfaceMap;
+
+static bool check(TetrahedronMesh &m, TriangleMesh &s, const SurfaceMap &map) {
+    unsigned long nt = s.getNTriangle(), ne = m.getNTetrahedron();
+    if (nt != m.getNBoundary() || map.vertex_volume.size() != s.getNVertex()) return false;
+    // 封闭曲面：没有边界边，V - E + F = 2
+    if (s.getNBoundary() != 0 || s.getNVertex() + nt != s.getNEdge() + 2) return false;
+
+    s.compute_geometry();
+    double area = 0;
+    for (unsigned long t = 0; t < nt; ++t) {
+        area += s.triangle_area()[t];
+        double out = 0;
+        for (int d = 0; d < 3; ++d) out += s.triangle_normal()[d][t] * (s.triangle_centroid()[d][t] - 0.5);
+        if (out <= 0) return false;
+
+        index_t f = map.face_volume[t], e = map.face_element[t];
+        if (m.face_info()[3][f] != e || m.face_info()[4][f] != ne + 1) return false;
+        index_t key[3];
+        for (int a = 0; a < 3; ++a) key[a] = map.vertex_volume[s.triangle()[a][t]];
+        std::sort(key, key + 3);
+        for (int a = 0; a < 3; ++a)
+            if (key[a] != m.face_info()[a][f]) return false;
+    }
+    for (unsigned long v = 0; v < s.getNVertex(); ++v)
+        if (s.x_coord()[v] != m.x_coord()[map.vertex_volume[v]]) return false;
+    return std::fabs(area - 6) < 1e-9 && map.nPatch == 6;
+}
+
+int main(int argc, char **argv) {
+    unsigned long n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 40;
+    int repeat = argc > 2 ? std::atoi(argv[2]) : 3;
+    unsigned max_threads = argc > 3 ? std::atoi(argv[3]) : std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+    int status = 0;
+
+    const std::string path = "bench_surface_tet.off";
+    bench::GeneratedMesh g = bench::structured_tet(n);
+    bench::shuffle(g, 12345);
+    bench::write_off(path, g);
+    TetrahedronMesh m;
+    m.read_off(path);
+    m.collect_faces();
+    std::cout << m.getNTetrahedron() << " tetrahedra, " << m.getNBoundary() << " boundary faces" << std::endl;
+
+    TriangleMesh s;
+    SurfaceMap map;
+    for (unsigned nt = 1; nt <= max_threads; nt *= 2) {
+        m.setNumThreads(nt);
+        double t_plain = bench::best_of(repeat, [&] { m.extract_boundary(s, map); });
+        double t_patch = bench::best_of(repeat, [&] { m.extract_boundary(s, map, 30); });
+        std::cout << "x" << std::left << std::setw(4) << nt << std::right << std::fixed << std::setprecision(4)
+                  << " extract " << std::setw(8) << t_plain << " s   with patches " << std::setw(8) << t_patch
+                  << " s   " << s.getNVertex() << " vertices, " << map.nPatch << " patches" << std::endl;
+        if (!check(m, s, map)) {
+            std::cout << "boundary surface is inconsistent!" << std::endl;
+            status = 1;
+        }
+    }
+
+    std::remove(path.c_str());
+    return status;
+}
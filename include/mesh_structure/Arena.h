@@ -0,0 +1,142 @@
+#ifndef MESH_STRUCTURE_ARENA_H
+#define MESH_STRUCTURE_ARENA_H
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include <sys/mman.h>
+
+#include "mesh_structure/Error.h"
+
+namespace mesh_structure {
+
+// 网格数组的存储区：每个网格一个，拥有全部坐标、单元、拓扑和几何数组
+// 所有数组按64字节对齐，不小于2MB的数组按2MB对齐并建议内核使用透明大页
+// 释放的数组不还给系统而是留在空闲池中，之后大小相近的分配直接复用，
+// 因此反复读入、提取、重排同样规模的网格时不再向系统申请内存；trim()归还空闲池
+// 只在串行代码中分配和释放，不是线程安全的
+class ArrayArena {
+public:
+    static constexpr size_t alignment = 64;
+    static constexpr size_t huge_page = 2ul << 20;
+
+    ArrayArena() : reserved_(0), in_use_(0), peak_(0) {}
+    ~ArrayArena() { clear(); }
+
+    ArrayArena(const ArrayArena &) = delete;
+    ArrayArena &operator=(const ArrayArena &) = delete;
+
+    ArrayArena(ArrayArena &&o) noexcept
+        : live_(std::move(o.live_)), pool_(std::move(o.pool_)), reserved_(o.reserved_), in_use_(o.in_use_),
+          peak_(o.peak_) {
+        o.live_.clear();
+        o.pool_.clear();
+        o.reserved_ = o.in_use_ = o.peak_ = 0;
+    }
+
+    ArrayArena &operator=(ArrayArena &&o) noexcept {
+        if (this != &o) {
+            clear();
+            live_.swap(o.live_);
+            pool_.swap(o.pool_);
+            std::swap(reserved_, o.reserved_);
+            std::swap(in_use_, o.in_use_);
+            std::swap(peak_, o.peak_);
+        }
+        return *this;
+    }
+
+    // 分配n个元素（未初始化）；n为0时也返回有效指针
+    template <class T>
+    T *allocate(unsigned long n) {
+        static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value,
+                      "ArrayArena only holds plain arrays");
+        size_t bytes = round_up(n * sizeof(T));
+        // 空闲池中最小的足够大的块，过大的块留给更大的数组
+        auto it = pool_.lower_bound(bytes);
+        void *p;
+        if (it != pool_.end() && it->first <= 2 * bytes) {
+            bytes = it->first;
+            p = it->second;
+            pool_.erase(it);
+        } else {
+            p = allocate_block(bytes);
+            reserved_ += bytes;
+        }
+        live_.emplace(p, bytes);
+        in_use_ += bytes;
+        if (in_use_ > peak_) peak_ = in_use_;
+        return static_cast<T *>(p);
+    }
+
+    // 把数组放回空闲池并置空指针；p为nullptr时什么也不做
+    template <class T>
+    void release(T *&p) {
+        if (p == nullptr) return;
+        auto it = live_.find(const_cast<void *>(static_cast<const void *>(p)));
+        if (it == live_.end()) {
+            throw MeshError("Array does not belong to this mesh arena!");
+        }
+        in_use_ -= it->second;
+        pool_.emplace(it->second, it->first);
+        live_.erase(it);
+        p = nullptr;
+    }
+
+    bool owns(const void *p) const { return live_.count(const_cast<void *>(p)) != 0; }
+
+    // 把空闲池中的块还给系统
+    void trim() {
+        for (auto &b : pool_) {
+            std::free(b.second);
+            reserved_ -= b.first;
+        }
+        pool_.clear();
+    }
+
+    // 释放全部块，之前分配的指针全部失效
+    void clear() {
+        for (auto &b : live_) std::free(b.first);
+        live_.clear();
+        trim();
+        reserved_ = in_use_ = peak_ = 0;
+    }
+
+    size_t bytes_reserved() const { return reserved_; }   // 向系统申请的字节数（含空闲池）
+    size_t bytes_in_use() const { return in_use_; }
+    // 使用量的峰值，可由set_peak重置（见Stats.h中的ScopedPhase）
+    size_t bytes_peak() const { return peak_; }
+    void set_peak(size_t bytes) { peak_ = std::max(bytes, in_use_); }
+
+private:
+    static size_t round_up(size_t bytes) {
+        size_t a = bytes >= huge_page ? huge_page : alignment;
+        return bytes == 0 ? alignment : (bytes + a - 1) / a * a;
+    }
+
+    static void *allocate_block(size_t bytes) {
+        size_t a = bytes >= huge_page ? huge_page : alignment;
+        void *p = std::aligned_alloc(a, bytes);
+        if (p == nullptr) {
+            throw MeshError(error_message("Cannot allocate ", bytes, " bytes for mesh arrays!"));
+        }
+#ifdef MADV_HUGEPAGE
+        if (a == huge_page) ::madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+        return p;
+    }
+
+    std::unordered_map<void *, size_t> live_;   // 使用中的块 -> 字节数
+    std::multimap<size_t, void *> pool_;        // 空闲池，按字节数排序
+    size_t reserved_;
+    size_t in_use_;
+    size_t peak_;
+};
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_ARENA_H
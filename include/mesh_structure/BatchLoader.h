@@ -0,0 +1,181 @@
+#ifndef MESH_STRUCTURE_BATCH_LOADER_H
+#define MESH_STRUCTURE_BATCH_LOADER_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "mesh_structure/Index.h"
+#include "mesh_structure/OffReader.h"
+#include "mesh_structure/TaskPool.h"
+
+namespace mesh_structure {
+
+// 批量读入：把许多OFF文件读入并提取子实体，结果以std::future返回，网格类型可以混合
+// 每个网格分为两个任务：读入（文件I/O和解析）和提取子实体。读入完成后提取任务放入同一工作线程的队列，
+// 一般由该线程接着执行，其他空闲线程则窃取尚未开始的读入任务，因此I/O和拓扑提取在不同网格间流水进行
+// 调度：
+//   - submit_all按估计的内存量从大到小提交，大作业先开始，小作业填补空闲（最长处理时间优先）
+//   - memory_budget不为0时限制同时处理中的网格的估计内存总量，超出时后续作业按提交顺序排队等待；
+//     单个超出预算的作业在没有其他作业处理中时单独执行
+//   - 线程预算：每个处理中的作业占用若干线程（作业所在的工作线程加上网格内部并行另起的线程），
+//     放行作业时占用的总数不超过线程池的线程数，没有空闲线程时后续作业排队等待。
+//     估计内存不小于big_job_bytes的作业在网格内部用放行时全部空闲的线程并行，其余单线程
+// 估计内存：文件大小加上点、单元和（按每个单元的子实体都不共享估计的）子实体数组
+class BatchLoader {
+public:
+    explicit BatchLoader(unsigned nthreads = 0, size_t memory_budget = 0, size_t big_job_bytes = 64ul << 20)
+        : pool_(nthreads), budget_(memory_budget), big_job_bytes_(big_job_bytes) {}
+
+    // 等待全部作业完成
+    ~BatchLoader() { wait(); }
+
+    BatchLoader(const BatchLoader &) = delete;
+    BatchLoader &operator=(const BatchLoader &) = delete;
+
+    // 提交一个作业，M为网格类型（如TriangleMesh、TetrahedronMesh）；读入或提取出错时异常由future.get()抛出
+    template <class M>
+    std::future<M> submit(const std::string &path) {
+        Job job = make_job<M>(path);
+        std::future<M> f = std::static_pointer_cast<std::promise<M>>(job.promise)->get_future();
+        enqueue({std::move(job)});
+        return f;
+    }
+
+    // 提交一批同类型的作业，返回的future与paths的顺序相同
+    template <class M>
+    std::vector<std::future<M>> submit_all(const std::vector<std::string> &paths) {
+        std::vector<Job> jobs;
+        std::vector<std::future<M>> futures;
+        for (const std::string &p : paths) {
+            jobs.push_back(make_job<M>(p));
+            futures.push_back(std::static_pointer_cast<std::promise<M>>(jobs.back().promise)->get_future());
+        }
+        std::stable_sort(jobs.begin(), jobs.end(), [](const Job &a, const Job &b) { return a.bytes > b.bytes; });
+        enqueue(std::move(jobs));
+        return futures;
+    }
+
+    // 等待已提交的作业全部完成
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [&] { return pending_.empty() && in_flight_jobs_ == 0; });
+    }
+
+    unsigned getNumThreads() const { return pool_.size(); }
+    // 处理中的作业的估计内存，及其最大值
+    size_t bytes_in_flight() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return in_flight_;
+    }
+    size_t peak_bytes_in_flight() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return peak_in_flight_;
+    }
+    // 处理中的作业占用的线程数的最大值，不超过getNumThreads()
+    unsigned peak_threads_in_use() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return peak_threads_;
+    }
+
+    // 作业的估计内存，只解析文件头；文件无法读取时按0估计，错误留到读入时由future报告
+    template <class M>
+    static size_t estimate_bytes(const std::string &path) {
+        try {
+            OffReader reader(path);
+            size_t nv = reader.nVertex(), ne = reader.nElement();
+            return reader.size() + nv * 3 * sizeof(double) +
+                   ne * (M::NV + M::NS + M::NS * (M::SV + 2)) * sizeof(index_t);
+        } catch (...) {
+            return 0;
+        }
+    }
+
+private:
+    struct Job {
+        size_t bytes;
+        std::shared_ptr<void> promise;
+        std::function<void(unsigned)> start;   // 参数为网格内部的线程数
+    };
+
+    template <class M>
+    Job make_job(const std::string &path) {
+        auto promise = std::make_shared<std::promise<M>>();
+        Job job;
+        job.promise = promise;
+        job.bytes = estimate_bytes<M>(path);
+        size_t bytes = job.bytes;
+        job.start = [this, promise, path, bytes](unsigned nthreads) {
+            auto mesh = std::make_shared<M>();
+            mesh->setNumThreads(nthreads);
+            try {
+                mesh->read_off(path);
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+                finish(bytes, nthreads);
+                return;
+            }
+            pool_.push([this, promise, mesh, bytes, nthreads] {
+                try {
+                    mesh->collect_sub_entities();
+                    promise->set_value(std::move(*mesh));
+                } catch (...) {
+                    promise->set_exception(std::current_exception());
+                }
+                finish(bytes, nthreads);
+            });
+        };
+        return job;
+    }
+
+    void enqueue(std::vector<Job> jobs) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (Job &j : jobs) pending_.push_back(std::move(j));
+        admit();
+    }
+
+    // 按提交顺序放行内存和线程预算内的作业（调用者持有mutex_）
+    void admit() {
+        while (!pending_.empty()) {
+            Job &j = pending_.front();
+            if (budget_ != 0 && in_flight_jobs_ != 0 && in_flight_ + j.bytes > budget_) break;
+            if (threads_in_use_ >= pool_.size()) break;
+            in_flight_ += j.bytes;
+            ++in_flight_jobs_;
+            peak_in_flight_ = std::max(peak_in_flight_, in_flight_);
+            unsigned nthreads = j.bytes >= big_job_bytes_ ? pool_.size() - threads_in_use_ : 1;
+            threads_in_use_ += nthreads;
+            peak_threads_ = std::max(peak_threads_, threads_in_use_);
+            pool_.push([start = std::move(j.start), nthreads] { start(nthreads); });
+            pending_.pop_front();
+        }
+    }
+
+    void finish(size_t bytes, unsigned nthreads) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        in_flight_ -= bytes;
+        --in_flight_jobs_;
+        threads_in_use_ -= nthreads;
+        admit();
+        if (pending_.empty() && in_flight_jobs_ == 0) done_.notify_all();
+    }
+
+    TaskPool pool_;
+    size_t budget_, big_job_bytes_;
+    std::mutex mutex_;
+    std::condition_variable done_;
+    std::deque<Job> pending_;
+    size_t in_flight_ = 0, peak_in_flight_ = 0;
+    unsigned long in_flight_jobs_ = 0;
+    unsigned threads_in_use_ = 0, peak_threads_ = 0;
+};
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_BATCH_LOADER_H
@@ -0,0 +1,79 @@
+#ifndef MESH_STRUCTURE_COLORING_H
+#define MESH_STRUCTURE_COLORING_H
+
+#include <algorithm>
+#include <cstdint>
+
+#include "mesh_structure/Arena.h"
+#include "mesh_structure/Error.h"
+#include "mesh_structure/Index.h"
+
+namespace mesh_structure {
+
+// 子实体着色：同一颜色中任意两个子实体没有公共的单元，按颜色并行处理子实体时，
+// 各线程写入两侧单元的数据不会冲突（见Mesh::for_each_sub）
+// 结果为颜色 -> 子实体的CSR：前nInteriorColor种颜色为内部子实体，之后的颜色为边界子实体，
+// 边界子实体占index末尾连续的一段。颜色内的子实体按编号（边界按boundary中的顺序）升序
+// 贪心着色：每个子实体取两侧单元都还没用过的最小颜色，单元有ns个子实体时颜色数不超过2*ns-1，
+// 边界子实体另外着色，不超过ns种。着色是一遍顺序扫描，代价与一次数组复制相当
+// left、right为子实体两侧的单元，边界子实体的right为nElement+1；返回总颜色数
+inline unsigned long color_subs(unsigned long nElement, unsigned long nSub, const index_t *left,
+                                const index_t *right, const index_t *boundary, unsigned long nBoundary,
+                                unsigned long &nInteriorColor, unsigned long *&offset, index_t *&index,
+                                ArrayArena &arena) {
+    const int max_color = 64;
+    uint64_t *used = arena.allocate<uint64_t>(nElement);
+    unsigned char *color = arena.allocate<unsigned char>(nSub);
+    unsigned long count[2 * max_color + 1] = {};
+    std::fill(used, used + nElement, 0);
+
+    auto pick = [&](uint64_t mask) {
+        if (~mask == 0) {
+            throw MeshError("Too many colors for the sub-entities, the mesh is not conforming!");
+        }
+        int c = 0;
+        while (mask >> c & 1) ++c;
+        return c;
+    };
+    unsigned long nInner = 0;
+    for (unsigned long s = 0; s < nSub; ++s) {
+        if (right[s] >= nElement) continue;
+        int c = pick(used[left[s]] | used[right[s]]);
+        used[left[s]] |= uint64_t(1) << c;
+        used[right[s]] |= uint64_t(1) << c;
+        color[s] = c;
+        ++count[c];
+        if (c + 1 > static_cast<int>(nInner)) nInner = c + 1;
+    }
+    for (unsigned long b = 0; b < nBoundary; ++b) used[left[boundary[b]]] = 0;
+    unsigned long nOuter = 0;
+    for (unsigned long b = 0; b < nBoundary; ++b) {
+        index_t s = boundary[b];
+        int c = pick(used[left[s]]);
+        used[left[s]] |= uint64_t(1) << c;
+        color[s] = c;
+        ++count[max_color + c];
+        if (c + 1 > static_cast<int>(nOuter)) nOuter = c + 1;
+    }
+
+    unsigned long nColor = nInner + nOuter;
+    offset = arena.allocate<unsigned long>(nColor + 1);
+    offset[0] = 0;
+    for (unsigned long c = 0; c < nColor; ++c)
+        offset[c + 1] = offset[c] + (c < nInner ? count[c] : count[max_color + c - nInner]);
+    index = arena.allocate<index_t>(offset[nColor]);
+    std::copy(offset, offset + nColor, count);
+    for (unsigned long s = 0; s < nSub; ++s)
+        if (right[s] < nElement) index[count[color[s]]++] = s;
+    for (unsigned long b = 0; b < nBoundary; ++b)
+        index[count[nInner + color[boundary[b]]]++] = boundary[b];
+
+    arena.release(used);
+    arena.release(color);
+    nInteriorColor = nInner;
+    return nColor;
+}
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_COLORING_H
@@ -0,0 +1,120 @@
+#ifndef MESH_STRUCTURE_CSR_H
+#define MESH_STRUCTURE_CSR_H
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "mesh_structure/Arena.h"
+#include "mesh_structure/Index.h"
+#include "mesh_structure/Parallel.h"
+
+namespace mesh_structure {
+
+// 一段连续的只读索引，可直接用于范围for循环
+class IndexSpan {
+public:
+    IndexSpan(const index_t *first, const index_t *last) : first_(first), last_(last) {}
+
+    const index_t *begin() const { return first_; }
+    const index_t *end() const { return last_; }
+    unsigned long size() const { return last_ - first_; }
+    bool empty() const { return first_ == last_; }
+    index_t operator[](unsigned long k) const { return first_[k]; }
+
+private:
+    const index_t *first_;
+    const index_t *last_;
+};
+
+// 压缩稀疏行(CSR)格式的邻接关系：第i行为index[offset[i] .. offset[i+1])
+// 非零元总数可能超出index_t的范围，offset用unsigned long，index用index_t
+// 视图不拥有数据，所属网格释放或重建邻接关系后失效
+class CsrView {
+public:
+    CsrView() : nRow_(0), offset_(nullptr), index_(nullptr) {}
+    CsrView(unsigned long nRow, const unsigned long *offset, const index_t *index)
+        : nRow_(nRow), offset_(offset), index_(index) {}
+
+    unsigned long nRow() const { return nRow_; }
+    unsigned long nnz() const { return offset_ == nullptr ? 0 : offset_[nRow_]; }
+    const unsigned long *offset() const { return offset_; }
+    const index_t *index() const { return index_; }
+    bool empty() const { return offset_ == nullptr; }
+
+    IndexSpan operator[](unsigned long i) const { return IndexSpan(index_ + offset_[i], index_ + offset_[i + 1]); }
+
+private:
+    unsigned long nRow_;
+    const unsigned long *offset_;
+    const index_t *index_;
+};
+
+
+// 两遍法构建CSR：emit(k, sink)对第k个条目调用sink(row, value)
+// 先并行计数、前缀和，再并行填充，最后每行排序使结果与线程数无关
+// offset(nRow+1)和index从arena分配
+template <class Emit>
+void build_csr(unsigned long nRow, unsigned long nItem, unsigned nthreads, Emit &&emit,
+               unsigned long *&offset, index_t *&index, ArrayArena &arena) {
+    offset = arena.allocate<unsigned long>(nRow + 1);
+    {
+        std::vector<std::atomic<unsigned long>> count(nRow);
+        parallel_for(0, nItem, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+            auto sink = [&](unsigned long row, unsigned long) { count[row].fetch_add(1, std::memory_order_relaxed); };
+            for (unsigned long k = lo; k < hi; ++k) emit(k, sink);
+        });
+        parallel_for(0, nRow, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+            for (unsigned long i = lo; i < hi; ++i) offset[i] = count[i].load(std::memory_order_relaxed);
+        });
+    }
+    offset[nRow] = 0;
+    unsigned long nnz = parallel_exclusive_scan(offset, nRow + 1, nthreads);
+    index = arena.allocate<index_t>(nnz);
+
+    std::vector<std::atomic<unsigned long>> cursor(nRow);
+    parallel_for(0, nRow, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        for (unsigned long i = lo; i < hi; ++i) cursor[i].store(offset[i], std::memory_order_relaxed);
+    });
+    parallel_for(0, nItem, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        auto sink = [&](unsigned long row, unsigned long value) {
+            index[cursor[row].fetch_add(1, std::memory_order_relaxed)] = value;
+        };
+        for (unsigned long k = lo; k < hi; ++k) emit(k, sink);
+    });
+    parallel_for(0, nRow, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        for (unsigned long i = lo; i < hi; ++i) std::sort(index + offset[i], index + offset[i + 1]);
+    });
+}
+
+// 单元-单元邻接：通过共享的子实体相连，按局部子实体顺序排列，边界上的子实体不产生邻居
+// conn[j][i]为单元i的第j个子实体，left/right为子实体两侧的单元；offset和index从arena分配
+template <int NS>
+void build_element_csr(unsigned long nElement, index_t *const *conn, const index_t *left,
+                       const index_t *right, unsigned nthreads, unsigned long *&offset, index_t *&index,
+                       ArrayArena &arena) {
+    offset = arena.allocate<unsigned long>(nElement + 1);
+    parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        for (unsigned long i = lo; i < hi; ++i) {
+            unsigned long c = 0;
+            for (int j = 0; j < NS; ++j) c += right[conn[j][i]] < nElement;
+            offset[i] = c;
+        }
+    });
+    offset[nElement] = 0;
+    index = arena.allocate<index_t>(parallel_exclusive_scan(offset, nElement + 1, nthreads));
+    parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        for (unsigned long i = lo; i < hi; ++i) {
+            unsigned long p = offset[i];
+            for (int j = 0; j < NS; ++j) {
+                index_t e = conn[j][i];
+                if (right[e] >= nElement) continue;
+                index[p++] = left[e] == i ? right[e] : left[e];
+            }
+        }
+    });
+}
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_CSR_H
@@ -0,0 +1,68 @@
+#ifndef MESH_STRUCTURE_DOF_H
+#define MESH_STRUCTURE_DOF_H
+
+#include <utility>
+
+#include "mesh_structure/Arena.h"
+#include "mesh_structure/Index.h"
+
+namespace mesh_structure {
+
+// 单纯形网格的Lagrange自由度编号：单元i的第k个局部自由度的全局编号为dof[i*nLocal + k]
+// 局部顺序：NV个点；P2每条局部棱一个（按Traits::edge的顺序）；P3每条局部棱两个（先靠近棱的第一个局部顶点的），
+// 再加三角形的一个单元内部自由度或四面体每个面一个（按Traits::local的顺序）
+// 每单元的局部自由度数：P1为3/4，P2为6/10，P3为10/20（三角形/四面体）
+// 数组在编号自己的存储区中，由Mesh::dof_map生成，重新生成时复用
+class DofMap {
+public:
+    DofMap() : order_(0), nLocal_(0), nElement_(0), nDof_(0), dof_(nullptr) {}
+
+    DofMap(const DofMap &) = delete;
+    DofMap &operator=(const DofMap &) = delete;
+    DofMap(DofMap &&o) noexcept : DofMap() { swap(o); }
+    DofMap &operator=(DofMap &&o) noexcept {
+        if (this != &o) {
+            DofMap tmp(std::move(o));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    void swap(DofMap &o) noexcept {
+        std::swap(arena_, o.arena_);
+        std::swap(order_, o.order_);
+        std::swap(nLocal_, o.nLocal_);
+        std::swap(nElement_, o.nElement_);
+        std::swap(nDof_, o.nDof_);
+        std::swap(dof_, o.dof_);
+    }
+
+    int order() const { return order_; }
+    int nLocal() const { return nLocal_; }
+    unsigned long nElement() const { return nElement_; }
+    unsigned long nDof() const { return nDof_; }
+    const index_t *dof() const { return dof_; }
+    // 单元i的nLocal个全局编号
+    const index_t *element(unsigned long i) const { return dof_ + static_cast<unsigned long>(nLocal_) * i; }
+
+    // 按新的规模重新分配，返回可写的编号数组（由Mesh::dof_map填写）
+    index_t *reset(int order, int nLocal, unsigned long nElement, unsigned long nDof) {
+        arena_.release(dof_);
+        order_ = order;
+        nLocal_ = nLocal;
+        nElement_ = nElement;
+        nDof_ = nDof;
+        dof_ = arena_.allocate<index_t>(static_cast<unsigned long>(nLocal) * nElement);
+        return dof_;
+    }
+
+private:
+    ArrayArena arena_;
+    int order_, nLocal_;
+    unsigned long nElement_, nDof_;
+    index_t *dof_;
+};
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_DOF_H
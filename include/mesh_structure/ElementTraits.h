@@ -0,0 +1,84 @@
+#ifndef MESH_STRUCTURE_ELEMENT_TRAITS_H
+#define MESH_STRUCTURE_ELEMENT_TRAITS_H
+
+#include <cstdint>
+
+namespace mesh_structure {
+
+// 单元类型的编译期描述，Mesh<Traits>据此展开所有按单元的循环
+//   dim:      单元的维数（2为曲面单元，子实体为边；3为体单元，子实体为面）
+//   nv:       每个单元的顶点数
+//   ns, sv:   每个单元的子实体数、每个子实体的顶点数
+//   local:    第j个子实体由单元的哪些局部顶点组成（面按环绕顺序给出）
+//   ne, edge: 每个单元的棱数、第k条棱的两个局部顶点（曲面单元的棱即子实体，顺序与local相同）
+//   reflect:  反转单元朝向的局部顶点置换，新的第k个顶点为原来的第reflect[k]个
+//   snapshot_type: 快照文件头中的element_type（三角形和四面体沿用3和4，其余为VTK单元类型编号）
+// 顶点编号与VTK一致
+
+struct TriangleTraits {
+    static constexpr int dim = 2;
+    static constexpr int nv = 3;
+    static constexpr int ns = 3;
+    static constexpr int sv = 2;
+    static constexpr int local[3][2] = {{0, 1}, {1, 2}, {2, 0}};   // 第j条边由第j和第j+1个顶点组成
+    static constexpr int ne = 3;
+    static constexpr int edge[3][2] = {{0, 1}, {1, 2}, {2, 0}};
+    static constexpr int reflect[3] = {0, 2, 1};
+    static constexpr uint32_t snapshot_type = 3;
+    static constexpr uint8_t vtk_type = 5;
+    static constexpr const char *tecplot_zone = "TRIANGLE";
+    static constexpr const char *title = "Triangular mesh";
+};
+
+struct QuadrilateralTraits {
+    static constexpr int dim = 2;
+    static constexpr int nv = 4;
+    static constexpr int ns = 4;
+    static constexpr int sv = 2;
+    static constexpr int local[4][2] = {{0, 1}, {1, 2}, {2, 3}, {3, 0}};
+    static constexpr int ne = 4;
+    static constexpr int edge[4][2] = {{0, 1}, {1, 2}, {2, 3}, {3, 0}};
+    static constexpr int reflect[4] = {0, 3, 2, 1};
+    static constexpr uint32_t snapshot_type = 9;
+    static constexpr uint8_t vtk_type = 9;
+    static constexpr const char *tecplot_zone = "QUADRILATERAL";
+    static constexpr const char *title = "Quadrilateral mesh";
+};
+
+struct TetrahedronTraits {
+    static constexpr int dim = 3;
+    static constexpr int nv = 4;
+    static constexpr int ns = 4;
+    static constexpr int sv = 3;
+    // 对正向的四面体，这些面的法向量（右手方向）指向单元内部
+    static constexpr int local[4][3] = {{0, 1, 2}, {0, 2, 3}, {0, 3, 1}, {3, 2, 1}};
+    static constexpr int ne = 6;
+    static constexpr int edge[6][2] = {{0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}};
+    static constexpr int reflect[4] = {0, 2, 1, 3};
+    static constexpr uint32_t snapshot_type = 4;
+    static constexpr uint8_t vtk_type = 10;
+    static constexpr const char *tecplot_zone = "TETRAHEDRON";
+    static constexpr const char *title = "Tetrahedral mesh";
+};
+
+struct HexahedronTraits {
+    static constexpr int dim = 3;
+    static constexpr int nv = 8;
+    static constexpr int ns = 6;
+    static constexpr int sv = 4;
+    // 顶点0-3为底面，4-7为顶面；对正向的六面体，这些面的法向量指向单元外部
+    static constexpr int local[6][4] = {{0, 3, 2, 1}, {4, 5, 6, 7}, {0, 1, 5, 4},
+                                        {1, 2, 6, 5}, {2, 3, 7, 6}, {3, 0, 4, 7}};
+    static constexpr int ne = 12;
+    static constexpr int edge[12][2] = {{0, 1}, {1, 2}, {2, 3}, {3, 0}, {4, 5}, {5, 6},
+                                        {6, 7}, {7, 4}, {0, 4}, {1, 5}, {2, 6}, {3, 7}};
+    static constexpr int reflect[8] = {0, 3, 2, 1, 4, 7, 6, 5};
+    static constexpr uint32_t snapshot_type = 12;
+    static constexpr uint8_t vtk_type = 12;
+    static constexpr const char *tecplot_zone = "BRICK";
+    static constexpr const char *title = "Hexahedral mesh";
+};
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_ELEMENT_TRAITS_H
@@ -0,0 +1,55 @@
+#ifndef MESH_STRUCTURE_ERROR_H
+#define MESH_STRUCTURE_ERROR_H
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace mesh_structure {
+
+// 库中的错误都以MeshError或其派生类抛出，what()为完整的错误信息；并行区域中抛出的异常在所有线程结束后重新抛出
+// MeshError: 参数或网格状态不正确、编号超出范围等
+class MeshError : public std::runtime_error {
+public:
+    explicit MeshError(const std::string &message) : std::runtime_error(message) {}
+};
+
+// 文件无法打开、映射或读写，或不是所需的格式；path()为文件路径
+class FileError : public MeshError {
+public:
+    FileError(const std::string &path, const std::string &message)
+        : MeshError(message + ": " + path), path_(path) {}
+
+    const std::string &path() const { return path_; }
+
+protected:
+    FileError(const std::string &path, const std::string &, const std::string &what)
+        : MeshError(what), path_(path) {}
+
+private:
+    std::string path_;
+};
+
+// 文本输入文件的内容有误；line()为出错的行号（从1开始），what()为"路径:行号: 信息"
+class ParseError : public FileError {
+public:
+    ParseError(const std::string &path, unsigned long line, const std::string &message)
+        : FileError(path, message, path + ":" + std::to_string(line) + ": " + message), line_(line) {}
+
+    unsigned long line() const { return line_; }
+
+private:
+    unsigned long line_;
+};
+
+// 把若干个值依次写入一个字符串，用于拼接错误信息
+template <class... Args>
+std::string error_message(const Args &...args) {
+    std::ostringstream s;
+    (s << ... << args);
+    return s.str();
+}
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_ERROR_H
@@ -0,0 +1,147 @@
+#ifndef MESH_STRUCTURE_EXTERNAL_SORT_H
+#define MESH_STRUCTURE_EXTERNAL_SORT_H
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include "mesh_structure/Error.h"
+
+namespace mesh_structure {
+
+// 外部排序：记录先放入内存缓冲区，缓冲区满时排序并写成临时文件（一个有序段），
+// merge时对所有段做k路归并。全部记录都能放入内存时不写任何文件
+// 记录类型必须可以按字节复制；临时文件位于scratch_dir，析构时删除
+template <class T, class Less = std::less<T>>
+class ExternalSorter {
+    static_assert(std::is_trivially_copyable<T>::value, "ExternalSorter records must be trivially copyable");
+
+public:
+    // memory_bytes: 内存缓冲区的字节数，归并时同样的内存平分给各段作读缓冲
+    ExternalSorter(const std::string &scratch_dir, size_t memory_bytes, Less less = Less())
+        : dir_(scratch_dir), capacity_(std::max<size_t>(memory_bytes / sizeof(T), 1024)), less_(less), size_(0) {}
+
+    ~ExternalSorter() {
+        for (Run &r : runs_) {
+            if (r.file != nullptr) std::fclose(r.file);
+            ::unlink(r.path.c_str());
+        }
+    }
+
+    ExternalSorter(const ExternalSorter &) = delete;
+    ExternalSorter &operator=(const ExternalSorter &) = delete;
+
+    void push(const T &v) {
+        if (buf_.capacity() == 0) buf_.reserve(capacity_);
+        buf_.push_back(v);
+        ++size_;
+        if (buf_.size() == capacity_) spill();
+    }
+
+    unsigned long size() const { return size_; }
+
+    // 按顺序对每个记录调用f(const T &)，只能调用一次
+    template <class F>
+    void merge(F &&f) {
+        std::sort(buf_.begin(), buf_.end(), less_);
+        if (runs_.empty()) {
+            for (const T &v : buf_) f(v);
+            std::vector<T>().swap(buf_);
+            return;
+        }
+        if (!buf_.empty()) spill();
+        std::vector<T>().swap(buf_);
+
+        const size_t nrun = runs_.size();
+        const size_t block = std::max<size_t>(capacity_ / nrun, 256);
+        std::vector<std::vector<T>> in(nrun);
+        std::vector<size_t> pos(nrun, 0);
+        auto fill = [&](size_t k) {
+            Run &r = runs_[k];
+            in[k].resize(block);
+            size_t n = std::fread(in[k].data(), sizeof(T), std::min<unsigned long>(block, r.remain), r.file);
+            if (n == 0 && r.remain > 0) fail(r.path);
+            r.remain -= n;
+            in[k].resize(n);
+            pos[k] = 0;
+            return n > 0;
+        };
+
+        // 堆顶为最小的记录，相等时取编号小的段，保证结果与内存中排序一致
+        auto greater = [&](const std::pair<T, size_t> &a, const std::pair<T, size_t> &b) {
+            if (less_(a.first, b.first)) return false;
+            if (less_(b.first, a.first)) return true;
+            return a.second > b.second;
+        };
+        std::priority_queue<std::pair<T, size_t>, std::vector<std::pair<T, size_t>>, decltype(greater)> heap(greater);
+        for (size_t k = 0; k < nrun; ++k) {
+            std::rewind(runs_[k].file);
+            runs_[k].remain = runs_[k].count;
+            if (fill(k)) heap.push(std::make_pair(in[k][0], k));
+        }
+        while (!heap.empty()) {
+            std::pair<T, size_t> top = heap.top();
+            heap.pop();
+            f(top.first);
+            size_t k = top.second;
+            if (++pos[k] == in[k].size() && !fill(k)) continue;
+            heap.push(std::make_pair(in[k][pos[k]], k));
+        }
+    }
+
+private:
+    struct Run {
+        std::string path;
+        FILE *file;
+        unsigned long count;
+        unsigned long remain;
+    };
+
+    void spill() {
+        std::sort(buf_.begin(), buf_.end(), less_);
+        std::string path = dir_ + "/mesh_sort_XXXXXX";
+        std::vector<char> name(path.begin(), path.end());
+        name.push_back('\0');
+        int fd = ::mkstemp(name.data());
+        if (fd < 0) {
+            throw FileError(dir_, "Cannot create scratch file in");
+        }
+        Run r;
+        r.path = name.data();
+        r.file = ::fdopen(fd, "w+b");
+        r.count = buf_.size();
+        r.remain = 0;
+        if (r.file == nullptr) {
+            ::close(fd);
+            ::unlink(r.path.c_str());
+            fail(r.path);
+        }
+        runs_.push_back(r);
+        if (std::fwrite(buf_.data(), sizeof(T), buf_.size(), r.file) != buf_.size() || std::fflush(r.file) != 0)
+            fail(r.path);
+        buf_.clear();
+    }
+
+    static void fail(const std::string &path) {
+        throw FileError(path, "I/O error on scratch file");
+    }
+
+    std::string dir_;
+    size_t capacity_;
+    Less less_;
+    unsigned long size_;
+    std::vector<T> buf_;
+    std::vector<Run> runs_;
+};
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_EXTERNAL_SORT_H
@@ -0,0 +1,41 @@
+#ifndef MESH_STRUCTURE_GEOMETRY_KERNELS_H
+#define MESH_STRUCTURE_GEOMETRY_KERNELS_H
+
+#include "mesh_structure/Index.h"
+
+namespace mesh_structure {
+
+// 批量几何计算，输入为SoA坐标数组和按单元存放的顶点编号（与网格类的存储方式相同）
+// 根据CPU在运行时选择AVX-512、AVX2或标量实现，各实现的结果只在舍入误差内不同
+// 数组由调用者分配，nthreads为0时使用全部硬件线程
+
+enum class SimdLevel { Scalar, AVX2, AVX512 };
+
+// CPU支持的最高指令集
+SimdLevel max_simd_level();
+// 当前使用的指令集；set_simd_level可以强制使用较低的指令集（超出CPU支持时取max_simd_level）
+SimdLevel simd_level();
+void set_simd_level(SimdLevel level);
+const char *simd_level_name(SimdLevel level);
+
+// 三角形的单位法向量（按顶点0->1->2的右手方向）和面积
+void triangle_normals(unsigned long n, const double *x, const double *y, const double *z,
+                      index_t *const *tri, double *const *normal, double *area, unsigned nthreads);
+
+// 四面体的有向体积，顶点1,2,3从顶点0看去为逆时针时为正
+void tetrahedron_volumes(unsigned long n, const double *x, const double *y, const double *z,
+                         index_t *const *tet, double *volume, unsigned nthreads);
+
+// 单元形心，nv为每个单元的顶点数（3或4）
+void element_centroids(unsigned long n, int nv, const double *x, const double *y, const double *z,
+                       index_t *const *elem, double *const *centroid, unsigned nthreads);
+
+// 三角形面的单位法向量和面积，法向量指向左侧单元（left[f]）之外
+// face为面的3个顶点，cell_centroid为单元形心（由element_centroids得到）
+void face_normals(unsigned long n, const double *x, const double *y, const double *z,
+                  index_t *const *face, const index_t *left, const double *const *cell_centroid,
+                  double *const *normal, double *area, unsigned nthreads);
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_GEOMETRY_KERNELS_H
@@ -0,0 +1,47 @@
+#ifndef MESH_STRUCTURE_HEXAHEDRON_MESH_H
+#define MESH_STRUCTURE_HEXAHEDRON_MESH_H
+
+#include <string>
+#include <vector>
+
+#include "mesh_structure/Mesh.h"
+
+// 六面体网格，子实体为四边形面；顶点编号与VTK_HEXAHEDRON一致，OFF文件中每个单元8个顶点
+// 实现在Mesh<HexahedronTraits>中（见Mesh.h），几何量用标量循环计算
+class HexahedronMesh : public mesh_structure::Mesh<mesh_structure::HexahedronTraits> {
+public:
+    // 深拷贝，见Mesh::clone_from
+    HexahedronMesh clone() const { HexahedronMesh m; m.clone_from(*this); return m; }
+
+    unsigned long getNFace(){  return nSub; }
+    unsigned long getNEdge(){  return nEdge; }
+    unsigned long getNHexahedron() { return nElement; }
+
+    mesh_structure::index_t **hexahedron()  { return elem_; }
+    mesh_structure::index_t **face_info() { return sub_; }   // 4个顶点（升序）和两侧的六面体
+    mesh_structure::index_t **hex_face_connection() { return elem_sub_conn_; }
+    mesh_structure::local_t **face_order_in_hex() { return sub_order_; }
+    mesh_structure::index_t **edge_info() { return edge_; }   // 2个顶点（升序）
+    mesh_structure::index_t **hex_edge_connection() { return elem_edge_conn_; }
+
+    mesh_structure::CsrView vertex_hexahedron() { return vertex_element(); }
+    mesh_structure::CsrView vertex_face() { return vertex_sub(); }
+    mesh_structure::CsrView hexahedron_hexahedron() { return element_element(); }
+
+    void collect_faces(){ collect_sub_entities(); }
+    void collect_edges(){ collect_mesh_edges(); }
+
+    static void collect_faces_out_of_core(const std::string &off_path, const std::string &snapshot_path,
+                                          size_t memory_budget, const std::string &scratch_dir = "."){
+        collect_sub_entities_out_of_core(off_path, snapshot_path, memory_budget, scratch_dir);
+    }
+
+    double *hexahedron_volume() { return elem_measure_; }
+    double **hexahedron_centroid() { return elem_centroid_; }
+    double **face_normal() { return sub_normal_; }
+    double *face_area() { return sub_area_; }
+};    // HexahedronMesh
+
+extern template class mesh_structure::Mesh<mesh_structure::HexahedronTraits>;
+
+#endif // MESH_STRUCTURE_HEXAHEDRON_MESH_H
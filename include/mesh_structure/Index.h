@@ -0,0 +1,41 @@
+#ifndef MESH_STRUCTURE_INDEX_H
+#define MESH_STRUCTURE_INDEX_H
+
+#include <cstdint>
+#include <limits>
+
+#include "mesh_structure/Error.h"
+
+// 连接关系数组（单元的顶点、子实体表、单元-子实体关系、边界、CSR邻接的索引）中编号的类型
+// 由构建选项MESH_STRUCTURE_INDEX_BITS决定（32或64，默认32）；个数、CSR偏移量和重排的perm数组仍用unsigned long
+#ifndef MESH_STRUCTURE_INDEX_BITS
+#define MESH_STRUCTURE_INDEX_BITS 32
+#endif
+
+namespace mesh_structure {
+
+#if MESH_STRUCTURE_INDEX_BITS == 64
+typedef uint64_t index_t;
+#elif MESH_STRUCTURE_INDEX_BITS == 32
+typedef uint32_t index_t;
+#else
+#error "MESH_STRUCTURE_INDEX_BITS must be 32 or 64"
+#endif
+
+// 子实体在单元中的局部序号，取值0..NS（NS表示不存在）
+typedef uint8_t local_t;
+
+// 点、单元和子实体个数的上限：边界子实体的第二个单元记为nElement+1，也必须能用index_t表示
+constexpr unsigned long max_index_count = static_cast<unsigned long>(std::numeric_limits<index_t>::max()) - 1;
+
+// 个数超出index_t的表示范围时报错
+inline void check_index_range(unsigned long n, const char *what) {
+    if (n > max_index_count) {
+        throw MeshError(error_message("Too many ", what, " (", n, ") for ", 8 * sizeof(index_t),
+                                      "-bit mesh indices, rebuild with MESH_STRUCTURE_INDEX_BITS=64!"));
+    }
+}
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_INDEX_H
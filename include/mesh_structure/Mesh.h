@@ -0,0 +1,508 @@
+#ifndef MESH_STRUCTURE_MESH_H
+#define MESH_STRUCTURE_MESH_H
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mesh_structure/Arena.h"
+#include "mesh_structure/Coloring.h"
+#include "mesh_structure/Csr.h"
+#include "mesh_structure/Dof.h"
+#include "mesh_structure/ElementTraits.h"
+#include "mesh_structure/MeshEdit.h"
+#include "mesh_structure/MeshWriter.h"
+#include "mesh_structure/Partition.h"
+#include "mesh_structure/Refine.h"
+#include "mesh_structure/Reorder.h"
+#include "mesh_structure/Snapshot.h"
+#include "mesh_structure/Sparsity.h"
+#include "mesh_structure/Stats.h"
+#include "mesh_structure/Surface.h"
+
+namespace mesh_structure {
+
+// 通用网格核心：单元类型由Traits在编译期给出（见ElementTraits.h），所有按单元、按子实体的循环在编译期展开
+// 子实体指曲面单元的边或体单元的面；点、单元和子实体的编号都从0开始
+// 成员函数的实现在MeshImpl.h中，各单元类型在自己的源文件中显式实例化
+template <class Traits>
+class Mesh {
+public:
+    static constexpr int NV = Traits::nv;   // 每个单元的顶点数
+    static constexpr int NS = Traits::ns;   // 每个单元的子实体数
+    static constexpr int SV = Traits::sv;   // 每个子实体的顶点数
+    static constexpr int NE = Traits::ne;   // 每个单元的棱数
+
+protected:
+    // 体网格的边界曲面直接写入曲面网格的数组
+    template <class> friend class Mesh;
+
+    unsigned long nVertex;       // 顶点数
+    unsigned long nElement;      // 单元数
+    unsigned long nSub;          // 子实体数，0表示尚未提取
+    unsigned long nBoundary;     // 边界子实体数
+    unsigned long nEdge;         // 体网格的棱数，0表示尚未提取
+    unsigned long nColor;        // 子实体的颜色数，0表示尚未着色
+    unsigned long nInteriorColor;// 其中内部子实体的颜色数
+    unsigned nThreads;           // 并行线程数，0表示使用全部硬件线程
+
+    double *x_;
+    double *y_;
+    double *z_;
+    index_t *boundary_;
+
+    // 连接关系中的编号为index_t（由构建选项决定，默认32位，见Index.h）
+    index_t *elem_[NV];
+    index_t *elem_sub_conn_[NS];   // elem_sub_conn_[j][i]: 单元i的第j个子实体
+    index_t *sub_[SV + 2];         // 子实体按升序排列的SV个顶点，以及两侧的单元（边界上第二个为nElement+1）
+    local_t *sub_order_[2];        // 子实体在两侧单元中的局部序号，不存在时为NS
+    index_t *edge_[2];             // 体网格的棱，按升序排列的两个端点
+    index_t *elem_edge_conn_[NE];  // elem_edge_conn_[k][i]: 单元i的第k条棱（局部顶点见Traits::edge）
+
+    // CSR格式的邻接关系，offset长度为行数+1
+    unsigned long *vtx_elem_offset_; index_t *vtx_elem_;    // vertex -> element
+    unsigned long *vtx_sub_offset_; index_t *vtx_sub_;      // vertex -> sub-entity
+    unsigned long *elem_elem_offset_; index_t *elem_elem_;  // element -> element (through shared sub-entities)
+    unsigned long *color_offset_; index_t *color_sub_;      // color -> sub-entity（见Coloring.h）
+
+    // 由compute_geometry计算的几何量
+    double *elem_measure_;         // 曲面单元的面积，体单元的有向体积
+    double *elem_centroid_[3];
+    double *elem_normal_[3];       // 曲面单元的单位法向量
+    double *sub_normal_[3];        // 体单元的面的单位法向量，指向左侧单元(sub_[SV])之外
+    double *sub_area_;
+
+    // 全部自有数组的存储区；释放的数组留在空闲池中，重新读入或重建时复用
+    ArrayArena arena_;
+    // 由read_snapshot映射的快照文件，其中的数组不属于arena_
+    SnapshotMapping snapshot_;
+    // 局部编辑的辅助结构，不在编辑时为空
+    std::unique_ptr<MeshEditState> edit_;
+    // 各阶段的统计，未开启时为空，各阶段只多一次空指针判断
+    std::unique_ptr<MeshStats> stats_;
+
+    // 释放一个数组并置空：映射区内的数组随映射一起释放，其余的放回arena_
+    template <class T>
+    void release_array(T *&p){
+        if (snapshot_.contains(p)){ p = nullptr; }
+        else { arena_.release(p); }
+    }
+
+    // 从arena_分配并复制n个元素
+    template <class T>
+    T *copy_array(const T *src, unsigned long n){
+        if (src == nullptr) return nullptr;
+        T *p = arena_.template allocate<T>(n);
+        std::copy(src, src + n, p);
+        return p;
+    }
+
+    // 释放子实体相关的数组，重复提取时先清空旧结果；正在进行的局部编辑随之结束
+    void release_sub(){
+        edit_.reset();
+        for (int i=0; i<SV+2; i++){ release_array(sub_[i]); }
+        for (int i=0; i<NS; i++){ release_array(elem_sub_conn_[i]); }
+        for (int i=0; i<2; i++){ release_array(sub_order_[i]); }
+        release_array(boundary_);
+        for (int i=0; i<3; i++){ release_array(sub_normal_[i]); }
+        release_array(sub_area_);
+        // 由子实体导出的邻接关系随之失效
+        release_array(vtx_sub_offset_); release_array(vtx_sub_);
+        release_array(elem_elem_offset_); release_array(elem_elem_);
+        release_coloring();
+        nSub=0;
+        nBoundary=0;
+    }
+
+    void release_coloring(){
+        release_array(color_offset_); release_array(color_sub_);
+        nColor=0;
+        nInteriorColor=0;
+    }
+
+    void release_edges(){
+        for (int i=0; i<2; i++){ release_array(edge_[i]); }
+        for (int i=0; i<NE; i++){ release_array(elem_edge_conn_[i]); }
+        nEdge=0;
+    }
+
+    void release_adjacency(){
+        unsigned long **offsets[3] = {&vtx_elem_offset_, &vtx_sub_offset_, &elem_elem_offset_};
+        index_t **indices[3] = {&vtx_elem_, &vtx_sub_, &elem_elem_};
+        for (int i=0; i<3; i++){ release_array(*offsets[i]); release_array(*indices[i]); }
+    }
+
+    void release_geometry(){
+        for (int i=0; i<3; i++){
+            release_array(elem_centroid_[i]);
+            release_array(elem_normal_[i]);
+            release_array(sub_normal_[i]);
+        }
+        release_array(elem_measure_);
+        release_array(sub_area_);
+    }
+
+    // 释放全部数组和快照映射，重新读入网格前调用
+    void release_all(){
+        release_geometry();
+        release_adjacency();
+        release_sub();
+        release_edges();
+        release_array(x_);
+        release_array(y_);
+        release_array(z_);
+        for (int i=0; i<NV; i++){ release_array(elem_[i]); }
+        snapshot_.close();
+        nVertex=0;
+        nElement=0;
+    }
+
+    // 接管提取结果中的数组
+    void take_topology(TopologyResult<NS, SV> &topo){
+        nSub = topo.nEntity;
+        nBoundary = topo.nBoundary;
+        for (int i=0; i<SV+2; i++){ sub_[i] = topo.entity[i]; }
+        for (int i=0; i<NS; i++){ elem_sub_conn_[i] = topo.conn[i]; }
+        sub_order_[0] = topo.order[0];
+        sub_order_[1] = topo.order[1];
+        boundary_ = topo.boundary;
+    }
+
+    // 翻转单元i的朝向
+    void reflect_element(unsigned long i){
+        index_t v[NV];
+        for (int k=0; k<NV; k++){ v[k] = elem_[Traits::reflect[k]][i]; }
+        for (int k=0; k<NV; k++){ elem_[k][i] = v[k]; }
+    }
+
+    // 每个单元的单位法向量和面积（曲面单元）或有向体积（体单元），不保存
+    void element_vector_area(double *const *normal, double *area);
+    void element_volume(double *volume);
+
+    // 局部编辑的内部操作（见MeshImpl.h）
+    void edit_resume();
+    template <class T>
+    void resize_array(T *&p, unsigned long n, unsigned long cap){
+        T *q = arena_.template allocate<T>(cap);
+        if (n != 0){ std::copy(p, p + n, q); }
+        release_array(p);
+        p = q;
+    }
+    void reserve_vertices(unsigned long n);
+    void reserve_elements(unsigned long n);
+    void reserve_subs(unsigned long n);
+    index_t find_sub(const index_t *key);
+    index_t insert_element(const index_t *v);
+    void erase_element(index_t i);
+    void erase_sub(index_t s);
+    void replace_elements(std::vector<index_t> &old_elements, const std::vector<index_t> &tuples);
+    std::vector<index_t> elements_with_edge(index_t a, index_t b);
+    double simplex_orientation(const index_t *v, const double *ref);
+    void move_vertex_slot(index_t from, index_t to);
+
+public:
+    Mesh(){
+        nVertex=0;
+        nElement=0;
+        nSub=0;
+        nBoundary=0;
+        nEdge=0;
+        nColor=0;
+        nInteriorColor=0;
+        nThreads=0;
+
+        x_=y_=z_=nullptr;
+        boundary_=nullptr;
+        for (int i=0; i<NV; i++){ elem_[i]=nullptr; }
+        for (int i=0; i<NS; i++){ elem_sub_conn_[i]=nullptr; }
+        for (int i=0; i<SV+2; i++){ sub_[i]=nullptr; }
+        sub_order_[0]=sub_order_[1]=nullptr;
+        edge_[0]=edge_[1]=nullptr;
+        for (int i=0; i<NE; i++){ elem_edge_conn_[i]=nullptr; }
+        vtx_elem_offset_=nullptr; vtx_elem_=nullptr;
+        vtx_sub_offset_=nullptr; vtx_sub_=nullptr;
+        elem_elem_offset_=nullptr; elem_elem_=nullptr;
+        color_offset_=nullptr; color_sub_=nullptr;
+        elem_measure_=sub_area_=nullptr;
+        for (int i=0; i<3; i++){ elem_centroid_[i]=elem_normal_[i]=sub_normal_[i]=nullptr; }
+    }
+
+    ~Mesh(){
+        release_all();
+    }
+
+    // 不能隐式复制，需要副本时用clone_from；移动只交换指针和存储区，不复制数据
+    Mesh(const Mesh &) = delete;
+    Mesh &operator=(const Mesh &) = delete;
+
+    Mesh(Mesh &&other) noexcept : Mesh() { swap(other); }
+
+    Mesh &operator=(Mesh &&other) noexcept {
+        if (this != &other){
+            Mesh tmp(std::move(other));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    void swap(Mesh &other) noexcept;
+
+    // 深拷贝另一个网格的全部数组（包括已提取的拓扑、邻接关系和几何量），快照映射的数组也复制到本网格的存储区
+    // 本网格原有的数组放回空闲池后再分配，规模相同时不向系统申请内存
+    void clone_from(const Mesh &other);
+
+    // 存储区：向系统申请的字节数、正在使用的字节数；release_storage把空闲池还给系统
+    size_t storage_bytes() const { return arena_.bytes_reserved(); }
+    size_t storage_bytes_in_use() const { return arena_.bytes_in_use(); }
+    void release_storage() { arena_.trim(); }
+
+    // 读入OFF文件，释放原有的全部数据。单元按文件中的顶点顺序保存，不调整朝向：三角形网格不再像原接口那样
+    // 保证逆时针排列，依赖朝向（法向量、有向面积或体积）的调用者需在读入后调用fix_orientation()
+    void read_off(const std::string &path);
+    // 不经文件直接建立网格：释放原有的全部数据，分配nVertex个点和nElement个单元的数组（内容未初始化），
+    // 之后由调用者通过x_coord()、element()等填写
+    void allocate(unsigned long nVertex, unsigned long nElement);
+
+    // 二进制快照：保存坐标、单元和提取得到的全部拓扑数组（见Snapshot.h）
+    // read_snapshot直接映射文件（写时复制），不解析也不重新计算
+    void write_snapshot(const std::string &path);
+    void read_snapshot(const std::string &path);
+
+    // 性能统计：开启后读入、提取、邻接、几何、重排、加密、输出等各阶段记录调用次数、耗时和存储区的峰值增量（见Stats.h）
+    // 统计随网格移动，不随clone_from复制；stats()在未开启时为nullptr，to_json/write_json输出为JSON
+    void enable_stats(bool on = true){
+        if (!on){ stats_.reset(); }
+        else if (!stats_){ stats_.reset(new MeshStats); }
+    }
+    const MeshStats *stats() const { return stats_.get(); }
+    void reset_stats(){ if (stats_){ stats_->clear(); } }
+
+    void setNumThreads(unsigned n) { nThreads = n; }
+    unsigned getNumThreads() { return nThreads; }
+
+    unsigned long getNVertex(){  return nVertex; }
+    unsigned long getNElement(){ return nElement; }
+    unsigned long getNSub(){ return nSub; }
+    unsigned long getNBoundary() { return nBoundary; }
+    index_t *boundary() { return boundary_; }
+    double *x_coord(){  return x_; }
+    double *y_coord(){  return y_; }
+    double *z_coord(){  return z_; }
+    // 修改坐标使几何量失效，修改单元使拓扑、邻接关系和几何量都失效，需要时重新提取或计算
+    void setX(double* x){ release_geometry(); for(unsigned long i=0; i<nVertex; i++){x_[i]= x[i];}}
+    void setY(double* y){ release_geometry(); for(unsigned long i=0; i<nVertex; i++){y_[i]= y[i];}}
+    void setZ(double* z){ release_geometry(); for(unsigned long i=0; i<nVertex; i++){z_[i]= z[i];}}
+
+    void setElement(index_t* elem[NV]){
+        release_geometry();
+        release_adjacency();
+        release_sub();
+        release_edges();
+        for(int i=0; i< NV; ++i){
+            for(unsigned long j=0; j<nElement; j++){
+                elem_[i][j] = elem[i][j];
+            }
+        }
+    }
+
+    index_t **element() { return elem_; }
+    index_t **sub_info() { return sub_; }
+    index_t **element_sub_connection() { return elem_sub_conn_; }
+    local_t **sub_order_in_element() { return sub_order_; }
+
+    // 提取子实体（边或面），按第一次出现的顺序编号
+    void collect_sub_entities();
+
+    // 外存模式：不把网格读入内存，由OFF文件直接生成包含子实体的快照文件，之后用read_snapshot映射
+    // 内存用量约为memory_budget字节（另加几MB的读写缓冲），临时文件写在scratch_dir中，结果与collect_sub_entities相同
+    static void collect_sub_entities_out_of_core(const std::string &off_path, const std::string &snapshot_path,
+                                                 size_t memory_budget, const std::string &scratch_dir = ".");
+
+    void find_vertex_element_connection(std::vector<unsigned long> *conn);
+
+    // 构建CSR格式的点-单元邻接；若已提取子实体，同时构建点-子实体和单元-单元邻接
+    void build_adjacency();
+
+    CsrView vertex_element() { return CsrView(vtx_elem_offset_ ? nVertex : 0, vtx_elem_offset_, vtx_elem_); }
+    CsrView vertex_sub() { return CsrView(vtx_sub_offset_ ? nVertex : 0, vtx_sub_offset_, vtx_sub_); }
+    CsrView element_element() { return CsrView(elem_elem_offset_ ? nElement : 0, elem_elem_offset_, elem_elem_); }
+
+    // 无冲突的并行子实体循环，用于有限体积通量等既读又写两侧单元的计算
+    // build_sub_coloring给子实体着色（见Coloring.h），同一颜色的子实体没有公共单元；
+    // 颜色 -> 子实体的CSR中内部子实体在前，边界子实体在后，为index末尾连续的一段
+    // 重新提取子实体或开始局部编辑时着色失效，reorder会自动重新着色；尚未提取子实体时先提取
+    void build_sub_coloring();
+    unsigned long getNColor() { return nColor; }
+    unsigned long getNInteriorColor() { return nInteriorColor; }
+    CsrView sub_coloring() { return CsrView(color_offset_ ? nColor : 0, color_offset_, color_sub_); }
+
+    // 按颜色逐个并行：内部子实体调用interior(s, left, right)，边界子实体调用boundary(s, left)
+    // 同一颜色内各线程处理不同的子实体，核函数可直接写两侧单元的数据而不需要加锁或原子操作
+    // 核函数作为模板参数传入，在循环中内联；尚未着色时先着色
+    template <class FI, class FB>
+    void for_each_sub(FI &&interior, FB &&boundary){
+        if (color_offset_ == nullptr){ build_sub_coloring(); }
+        unsigned nthreads = resolve_threads(nThreads);
+        const index_t *left = sub_[SV], *right = sub_[SV + 1], *subs = color_sub_;
+        for (unsigned long c=0; c<nColor; c++){
+            if (c < nInteriorColor){
+                parallel_for(color_offset_[c], color_offset_[c + 1], nthreads,
+                             [&](unsigned long lo, unsigned long hi, unsigned){
+                    for (unsigned long k = lo; k < hi; ++k){ index_t s = subs[k]; interior(s, left[s], right[s]); }
+                });
+            } else {
+                parallel_for(color_offset_[c], color_offset_[c + 1], nthreads,
+                             [&](unsigned long lo, unsigned long hi, unsigned){
+                    for (unsigned long k = lo; k < hi; ++k){ index_t s = subs[k]; boundary(s, left[s]); }
+                });
+            }
+        }
+    }
+
+    // 单元所有(owner-computes)：按单元并行，对单元i的每个子实体调用kernel(i, j, s, other)，
+    // j为局部序号，other为另一侧的单元（边界上为nElement+1）。每个线程只写自己的单元，不需要着色，
+    // 但内部子实体在两侧各算一次；尚未提取子实体时先提取
+    template <class F>
+    void for_each_element_sub(F &&kernel){
+        if (nSub == 0 && nElement != 0){ collect_sub_entities(); }
+        unsigned nthreads = resolve_threads(nThreads);
+        const index_t *left = sub_[SV], *right = sub_[SV + 1];
+        parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned){
+            for (unsigned long i = lo; i < hi; ++i){
+                for (int j=0; j<NS; j++){
+                    index_t s = elem_sub_conn_[j][i];
+                    kernel(static_cast<index_t>(i), j, s, left[s] == i ? right[s] : left[s]);
+                }
+            }
+        });
+    }
+
+    // 体网格的棱表：按(较小端点, 较大端点)升序编号，与子实体一样由点 -> 单元的CSR并行提取（见Refine.h中的collect_edges），
+    // 结果与线程数无关。曲面网格的棱即子实体，不需要另外提取（collect_mesh_edges对曲面网格什么也不做）
+    // 修改单元或开始局部编辑时棱表失效，reorder会自动重新提取；不写入快照
+    void collect_mesh_edges();
+    unsigned long getNMeshEdge() { return nEdge; }
+    index_t **mesh_edge() { return edge_; }
+    index_t **element_edge_connection() { return elem_edge_conn_; }
+
+    // 单纯形网格（三角形、四面体）的Lagrange自由度编号（见Dof.h），order为1、2或3，按单元并行一次写出
+    // 全局编号依次为点、棱、（P3）三角形的单元内部或四面体的面；尚未提取所需的子实体或棱表时先提取
+    void dof_map(int order, DofMap &map);
+
+    // 稀疏矩阵的非零结构和组装用的散布表（见Sparsity.h），按本网格的线程数并行生成，结果与线程数无关
+    // vertex_pattern: 点-点（P1/Q1有限元），同一单元中的两个点相连，散布表按单元
+    // element_pattern: 单元-单元（有限体积），通过内部子实体相邻的单元相连，散布表按子实体；尚未提取子实体时先提取
+    // 结构不随网格更新，修改单元或重排后需重新生成
+    void vertex_pattern(SparsityPattern &pattern);
+    void element_pattern(SparsityPattern &pattern);
+
+    // 统一单元朝向，返回翻转的单元数；read_off不调整朝向，需要时在读入后调用
+    // 体单元：使有向体积为正
+    // 曲面单元：经由边把朝向传播到每个连通分量（相邻单元在公共边上走向相反），
+    //           封闭曲面使包围的有向体积为正（法向量朝外），否则使在xy平面上的有向投影面积为正
+    unsigned long fix_orientation();
+
+    // 计算几何量：单元形心和面积/有向体积；曲面单元另有单位法向量，体单元在已提取面时另有面的单位法向量和面积
+    // 三角形和四面体使用SIMD批量核函数（见GeometryKernels.h）
+    // 结果保存在网格中，修改坐标或单元后需重新调用；reorder会自动重新计算
+    void compute_geometry();
+    double *element_measure() { return elem_measure_; }
+    double **element_centroid() { return elem_centroid_; }
+    double **element_normal() { return elem_normal_; }
+    double **sub_normal() { return sub_normal_; }
+    double *sub_area() { return sub_area_; }
+
+    // 重排点、单元和子实体的编号以改善访存局部性，所有连接关系同步更新，已构建的邻接关系和几何量会重新计算
+    // 各perm数组由调用者分配（可为nullptr），返回 新编号 -> 旧编号，用于重排场数据：f_new[k] = f_old[perm[k]]
+    void reorder(ReorderMethod method, unsigned long *vertex_perm, unsigned long *elem_perm,
+                 unsigned long *sub_perm = nullptr);
+
+    // 局部编辑：begin_edit之后可以逐个增删点和单元，或做单纯形的局部操作，子实体表、单元-子实体关系和
+    // 序号数组随之局部更新，不再整体重新提取。删除单元或子实体时用最后一个填补空位（被移动的记为已修改），编号始终连续
+    // commit_edits整理边界子实体列表，并给出自上次提交以来新增或修改的点、单元和子实体（changed_*，到下次提交前有效）；
+    // compact为true时另外删除不再被任何单元引用的点，并把数组收缩到实际大小
+    // 两次提交之间boundary()不更新，边界子实体的第二个单元记为edit_none；开始编辑时释放邻接关系和几何量
+    // 重新读入、重新提取、重排等整体操作会结束编辑
+    void begin_edit();
+    void commit_edits(bool compact = false);
+    void end_edit(){ commit_edits(); edit_.reset(); }
+    bool editing() const { return edit_ != nullptr; }
+
+    const std::vector<index_t> &changed_vertices() const { return edit_ ? edit_->changed_vertex : MeshEditState::none(); }
+    const std::vector<index_t> &changed_elements() const { return edit_ ? edit_->changed_element : MeshEditState::none(); }
+    const std::vector<index_t> &changed_subs() const { return edit_ ? edit_->changed_sub : MeshEditState::none(); }
+
+    index_t add_vertex(double x, double y, double z);
+    void move_vertex(index_t v, double x, double y, double z);
+    // 按给定的顶点顺序（即朝向）加入单元，返回其编号；会使某个子实体有两个以上的单元时报错
+    index_t add_element(const index_t *v);
+    void remove_element(index_t i);
+
+    // 单纯形网格（三角形、四面体）的局部操作
+    // split_edge: 在边ab上的点(x,y,z)处插入新点，包含该边的每个单元一分为二，返回新点
+    // split_element: 在单元i内插入新点，单元分为NV个，返回新点
+    // flip_sub: 三角形的边翻转(2-2)或四面体的面翻转(2-3)；边界子实体、翻转后有单元退化或反向、
+    //           新的边或面已存在时不做修改并返回false
+    // collapse_edge: 把点b合并到点a（a的坐标不变），删除包含边ab的单元；会产生非流形子实体、重复单元或
+    //                使单元反向时不做修改并返回false。点b留在数组中，直到commit_edits(true)
+    index_t split_edge(index_t a, index_t b, double x, double y, double z);
+    index_t split_element(index_t i, double x, double y, double z);
+    bool flip_sub(index_t s);
+    bool collapse_edge(index_t a, index_t b);
+
+    // 一致加密（仅三角形、四面体网格）：三角形1分4，四面体1分8（内部的八面体沿最短的对角线剖分），结果写入fine，原网格不变
+    // 细网格的前nVertex个点即原来的点，之后为各边的中点（三角形按边的编号，四面体按(较小端点, 较大端点)升序）；
+    // 单元i的子单元为2^dim*i起的连续2^dim个，朝向与父单元相同；父子实体f的子实体为n*f起的连续n个（三角形n=2，四面体n=4），
+    // 单元内部的新子实体排在它们之后。子实体表、单元-子实体关系和边界列表由父网格的相应数组直接写出，不重新提取
+    // element_parent（细网格单元数）和vertex_parent（2倍细网格点数，原有的点两个都是它自己）可选输出父单元和中点所在边的端点
+    // 尚未提取子实体时先提取
+    void refine_uniform(Mesh &fine, index_t *element_parent = nullptr, index_t *vertex_parent = nullptr);
+
+    // 边界曲面（体网格）：把边界面取出为独立的曲面网格（四面体网格为三角形网格，六面体网格为四边形网格），
+    // 只访问边界面及其所在的单元。曲面点按体网格编号升序重新编号，面的朝向为所在单元的外法向，曲面的边表随之提取
+    // feature_angle（度）不小于0时按特征角把曲面分为面片：相邻面的法向量夹角不超过该值的连成一片
+    // 尚未提取子实体时先提取；四面体和六面体网格的源文件中显式实例化
+    template <class ST>
+    void extract_boundary(Mesh<ST> &surf, SurfaceMap &map, double feature_angle = -1);
+
+    // 分区：按单元形心的递归坐标二分把单元分为nParts个部分，part[i]为单元i所属的部分（调用者分配nElement个）
+    // 返回交界子实体数（两侧单元属于不同部分的子实体）；尚未提取子实体时先提取
+    unsigned long partition(unsigned long nParts, index_t *part);
+
+    // 按划分结果生成各部分的子网格和编号映射（见Partition.h中的PartMap），各部分并行生成
+    // 子网格包含自有单元和一层幽灵单元，子实体已提取；尚未提取子实体时先在本网格上提取
+    void extract_parts(const index_t *part, unsigned long nParts, Mesh *const *subs, PartMap *maps);
+
+    template <class M>
+    void extract_parts(const index_t *part, unsigned long nParts, std::vector<M> &subs, std::vector<PartMap> &maps){
+        subs.resize(nParts);
+        maps.resize(nParts);
+        std::vector<Mesh *> p(nParts);
+        for (unsigned long k=0; k<nParts; k++){ p[k] = &subs[k]; }
+        extract_parts(part, nParts, p.data(), maps.data());
+    }
+
+    // 把各部分写成文件：prefix.<k>.snap为子网格快照，prefix.<k>.map为编号映射，分别用read_snapshot和read_part_map读回
+    template <class M>
+    static void write_parts(const std::string &prefix, std::vector<M> &subs, const std::vector<PartMap> &maps){
+        for (unsigned long k=0; k<subs.size(); k++){
+            std::string base = prefix + "." + std::to_string(k);
+            subs[k].write_snapshot(base + ".snap");
+            write_part_map(base + ".map", maps[k]);
+        }
+    }
+
+    // 输出Tecplot ASCII文件（单元编号从1开始）；vertex_fields为每个点一个值的场，cell_fields为每个单元一个值的场
+    void outputTecPlotDataFile(const char *fname, const std::vector<MeshField> &vertex_fields = {},
+                               const std::vector<MeshField> &cell_fields = {});
+
+    // 输出VTK XML非结构网格文件(.vtu)，数据为追加的原始二进制
+    void outputVTUFile(const char *fname, const std::vector<MeshField> &vertex_fields = {},
+                       const std::vector<MeshField> &cell_fields = {});
+};
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_MESH_H
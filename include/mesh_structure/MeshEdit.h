@@ -0,0 +1,35 @@
+#ifndef MESH_STRUCTURE_MESH_EDIT_H
+#define MESH_STRUCTURE_MESH_EDIT_H
+
+#include <limits>
+#include <vector>
+
+#include "mesh_structure/Index.h"
+
+namespace mesh_structure {
+
+// 编辑过程中（两次commit_edits之间）边界子实体的第二个单元记为edit_none，而不是随单元数变化的nElement+1
+constexpr index_t edit_none = std::numeric_limits<index_t>::max();
+
+// 局部编辑的辅助结构（见Mesh::begin_edit），由网格持有，结束编辑时释放
+struct MeshEditState {
+    std::vector<std::vector<index_t>> vertex_elements;   // 点 -> 包含它的单元，用于查找子实体和收缩
+    unsigned long cap_vertex = 0;    // 点、单元、子实体数组的容量，按倍数增长
+    unsigned long cap_element = 0;
+    unsigned long cap_sub = 0;
+    bool committed = true;           // 子实体表和boundary_处于提交后的形式
+
+    // 自上次提交以来新增或修改的编号，可能重复，也可能因为之后的删除而越界
+    std::vector<index_t> dirty_vertex, dirty_element, dirty_sub;
+    // 上次提交时整理得到的结果：升序、不重复
+    std::vector<index_t> changed_vertex, changed_element, changed_sub;
+
+    static const std::vector<index_t> &none() {
+        static const std::vector<index_t> empty;
+        return empty;
+    }
+};
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_MESH_EDIT_H
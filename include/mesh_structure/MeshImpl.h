@@ -0,0 +1,1549 @@
+#ifndef MESH_STRUCTURE_MESH_IMPL_H
+#define MESH_STRUCTURE_MESH_IMPL_H
+
+// Mesh<Traits>成员函数的实现。只需在实例化网格类型的源文件中包含
+// （库中已实例化三角形、四边形、四面体和六面体网格）
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <cmath>
+#include <vector>
+
+#include "mesh_structure/GeometryKernels.h"
+#include "mesh_structure/Mesh.h"
+#include "mesh_structure/OffReader.h"
+#include "mesh_structure/OutOfCoreTopology.h"
+#include "mesh_structure/Parallel.h"
+#include "mesh_structure/TopologyBuilder.h"
+
+namespace mesh_structure {
+
+template <class Traits>
+void Mesh<Traits>::swap(Mesh &o) noexcept {
+    std::swap(nVertex, o.nVertex);
+    std::swap(nElement, o.nElement);
+    std::swap(nSub, o.nSub);
+    std::swap(nBoundary, o.nBoundary);
+    std::swap(nEdge, o.nEdge);
+    std::swap(nColor, o.nColor);
+    std::swap(nInteriorColor, o.nInteriorColor);
+    std::swap(nThreads, o.nThreads);
+    std::swap(x_, o.x_);
+    std::swap(y_, o.y_);
+    std::swap(z_, o.z_);
+    std::swap(boundary_, o.boundary_);
+    std::swap(elem_, o.elem_);
+    std::swap(elem_sub_conn_, o.elem_sub_conn_);
+    std::swap(sub_, o.sub_);
+    std::swap(sub_order_, o.sub_order_);
+    std::swap(edge_, o.edge_);
+    std::swap(elem_edge_conn_, o.elem_edge_conn_);
+    std::swap(vtx_elem_offset_, o.vtx_elem_offset_);
+    std::swap(vtx_elem_, o.vtx_elem_);
+    std::swap(vtx_sub_offset_, o.vtx_sub_offset_);
+    std::swap(vtx_sub_, o.vtx_sub_);
+    std::swap(elem_elem_offset_, o.elem_elem_offset_);
+    std::swap(elem_elem_, o.elem_elem_);
+    std::swap(color_offset_, o.color_offset_);
+    std::swap(color_sub_, o.color_sub_);
+    std::swap(elem_measure_, o.elem_measure_);
+    std::swap(elem_centroid_, o.elem_centroid_);
+    std::swap(elem_normal_, o.elem_normal_);
+    std::swap(sub_normal_, o.sub_normal_);
+    std::swap(sub_area_, o.sub_area_);
+    std::swap(arena_, o.arena_);
+    std::swap(snapshot_, o.snapshot_);
+    std::swap(edit_, o.edit_);
+    std::swap(stats_, o.stats_);
+}
+
+
+template <class Traits>
+void Mesh<Traits>::clone_from(const Mesh &o){
+    ScopedPhase phase(stats_.get(), "clone_from", arena_);
+    if (this == &o) return;
+    if (o.edit_ && !o.edit_->committed){
+        throw MeshError("Cannot clone a mesh with uncommitted edits, call commit_edits first!");
+    }
+    release_all();
+    nVertex = o.nVertex;
+    nElement = o.nElement;
+    nSub = o.nSub;
+    nBoundary = o.nBoundary;
+    nEdge = o.nEdge;
+    nThreads = o.nThreads;
+
+    x_ = copy_array(o.x_, nVertex);
+    y_ = copy_array(o.y_, nVertex);
+    z_ = copy_array(o.z_, nVertex);
+    for (int i=0; i<NV; i++){ elem_[i] = copy_array(o.elem_[i], nElement); }
+    for (int i=0; i<NS; i++){ elem_sub_conn_[i] = copy_array(o.elem_sub_conn_[i], nElement); }
+    for (int i=0; i<SV+2; i++){ sub_[i] = copy_array(o.sub_[i], nSub); }
+    for (int i=0; i<2; i++){ sub_order_[i] = copy_array(o.sub_order_[i], nSub); }
+    boundary_ = copy_array(o.boundary_, nBoundary);
+    for (int i=0; i<2; i++){ edge_[i] = copy_array(o.edge_[i], nEdge); }
+    for (int i=0; i<NE; i++){ elem_edge_conn_[i] = copy_array(o.elem_edge_conn_[i], nElement); }
+
+    if (o.vtx_elem_offset_ != nullptr){
+        vtx_elem_offset_ = copy_array(o.vtx_elem_offset_, nVertex + 1);
+        vtx_elem_ = copy_array(o.vtx_elem_, vtx_elem_offset_[nVertex]);
+    }
+    if (o.vtx_sub_offset_ != nullptr){
+        vtx_sub_offset_ = copy_array(o.vtx_sub_offset_, nVertex + 1);
+        vtx_sub_ = copy_array(o.vtx_sub_, vtx_sub_offset_[nVertex]);
+    }
+    if (o.elem_elem_offset_ != nullptr){
+        elem_elem_offset_ = copy_array(o.elem_elem_offset_, nElement + 1);
+        elem_elem_ = copy_array(o.elem_elem_, elem_elem_offset_[nElement]);
+    }
+    if (o.color_offset_ != nullptr){
+        nColor = o.nColor;
+        nInteriorColor = o.nInteriorColor;
+        color_offset_ = copy_array(o.color_offset_, nColor + 1);
+        color_sub_ = copy_array(o.color_sub_, color_offset_[nColor]);
+    }
+
+    elem_measure_ = copy_array(o.elem_measure_, nElement);
+    for (int i=0; i<3; i++){
+        elem_centroid_[i] = copy_array(o.elem_centroid_[i], nElement);
+        elem_normal_[i] = copy_array(o.elem_normal_[i], nElement);
+        sub_normal_[i] = copy_array(o.sub_normal_[i], nSub);
+    }
+    sub_area_ = copy_array(o.sub_area_, nSub);
+}
+
+
+template <class Traits>
+void Mesh<Traits>::read_off(const std::string &path) {
+    ScopedPhase phase(stats_.get(), "read_off", arena_);
+    OffReader reader(path);
+    release_all();
+    nVertex  = reader.nVertex();
+    nElement = reader.nElement();
+
+    x_ = arena_.template allocate<double>(nVertex);
+    y_ = arena_.template allocate<double>(nVertex);
+    z_ = arena_.template allocate<double>(nVertex);
+    for (int i=0; i<NV; i++){ elem_[i] = arena_.template allocate<index_t>(nElement); }
+
+    reader.read(x_, y_, z_, elem_, NV, resolve_threads(nThreads));
+}
+
+
+template <class Traits>
+void Mesh<Traits>::allocate(unsigned long nv, unsigned long ne){
+    check_index_range(nv, "vertices");
+    check_index_range(ne, "elements");
+    release_all();
+    nVertex = nv;
+    nElement = ne;
+    x_ = arena_.template allocate<double>(nVertex);
+    y_ = arena_.template allocate<double>(nVertex);
+    z_ = arena_.template allocate<double>(nVertex);
+    for (int i=0; i<NV; i++){ elem_[i] = arena_.template allocate<index_t>(nElement); }
+}
+
+
+// 寻找与点相邻的单元
+template <class Traits>
+void Mesh<Traits>::find_vertex_element_connection(std::vector<unsigned long> *conn){
+    for (unsigned long i =0; i< nElement; ++i){
+        for (int j=0; j<NV; j++){
+            conn[elem_[j][i]].push_back(i);
+        }
+    }
+}
+
+
+template <class Traits>
+void Mesh<Traits>::build_adjacency(){
+    ScopedPhase phase(stats_.get(), "build_adjacency", arena_);
+    release_adjacency();
+    unsigned nthreads = resolve_threads(nThreads);
+
+    build_csr(nVertex, nElement, nthreads, [&](unsigned long i, auto &&sink){
+        for (int j=0; j<NV; j++){ sink(elem_[j][i], i); }
+    }, vtx_elem_offset_, vtx_elem_, arena_);
+
+    if (nSub == 0) return;
+    build_csr(nVertex, nSub, nthreads, [&](unsigned long f, auto &&sink){
+        for (int j=0; j<SV; j++){ sink(sub_[j][f], f); }
+    }, vtx_sub_offset_, vtx_sub_, arena_);
+    build_element_csr<NS>(nElement, elem_sub_conn_, sub_[SV], sub_[SV + 1], nthreads,
+                          elem_elem_offset_, elem_elem_, arena_);
+}
+
+
+template <class Traits>
+void Mesh<Traits>::build_sub_coloring(){
+    ScopedPhase phase(stats_.get(), "build_sub_coloring", arena_);
+    if (edit_ && !edit_->committed){
+        throw MeshError("Cannot color the sub-entities during uncommitted edits, call commit_edits first!");
+    }
+    if (nSub == 0 && nElement != 0){ collect_sub_entities(); }
+    release_coloring();
+    nColor = color_subs(nElement, nSub, sub_[SV], sub_[SV + 1], boundary_, nBoundary, nInteriorColor,
+                        color_offset_, color_sub_, arena_);
+}
+
+
+template <class Traits>
+void Mesh<Traits>::collect_mesh_edges(){
+    if constexpr (Traits::dim == 3){
+        ScopedPhase phase(stats_.get(), "collect_mesh_edges", arena_);
+        if (edit_ && !edit_->committed){
+            throw MeshError("Cannot collect the edges during uncommitted edits, call commit_edits first!");
+        }
+        release_edges();
+        nEdge = collect_edges<NV, NE>(nVertex, nElement, elem_, Traits::edge, resolve_threads(nThreads),
+                                      edge_, elem_edge_conn_, arena_);
+    }
+}
+
+
+// 局部编号：点，各棱（P2一个，P3两个，按局部棱的方向），P3再加三角形的单元内部或四面体的各面
+// 全局编号：点v为v；P2棱e为nVertex+e；P3棱e的两个自由度为nVertex+2e和nVertex+2e+1，
+// 前一个靠近编号较小的端点，使共享棱的单元得到相同的编号；之后为单元内部（三角形）或面（四面体）
+template <class Traits>
+void Mesh<Traits>::dof_map(int order, DofMap &map){
+    ScopedPhase phase(stats_.get(), "dof_map", arena_);
+    if constexpr (NV != Traits::dim + 1){
+        throw MeshError("Lagrange degrees of freedom require a triangle or tetrahedron mesh!");
+    } else {
+        if (order < 1 || order > 3){
+            throw MeshError(error_message("Unsupported Lagrange order ", order, ", expected 1, 2 or 3!"));
+        }
+        if (edit_ && !edit_->committed){
+            throw MeshError("Cannot number the degrees of freedom during uncommitted edits, call commit_edits first!");
+        }
+        // 三角形的棱即子实体；四面体的P3另需面
+        bool need_sub = Traits::dim == 2 ? order > 1 : order > 2;
+        if (need_sub && nSub == 0 && nElement != 0){ collect_sub_entities(); }
+        if (Traits::dim == 3 && order > 1 && nEdge == 0 && nElement != 0){ collect_mesh_edges(); }
+
+        unsigned long nE = Traits::dim == 2 ? nSub : nEdge;
+        index_t *const *edge = Traits::dim == 2 ? sub_ : edge_;
+        index_t *const *elem_edge = Traits::dim == 2 ? elem_sub_conn_ : elem_edge_conn_;
+        const int nInner = Traits::dim == 2 ? 1 : NS;
+        int nLocal = order == 1 ? NV : order == 2 ? NV + NE : NV + 2 * NE + nInner;
+        unsigned long nDof = order == 1 ? nVertex : order == 2 ? nVertex + nE
+                                                  : nVertex + 2 * nE + (Traits::dim == 2 ? nElement : nSub);
+        check_index_range(nDof, "degrees of freedom");
+
+        index_t *dof = map.reset(order, nLocal, nElement, nDof);
+        parallel_for(0, nElement, resolve_threads(nThreads), [&](unsigned long lo, unsigned long hi, unsigned){
+            for (unsigned long i = lo; i < hi; ++i){
+                index_t *d = dof + static_cast<unsigned long>(nLocal) * i;
+                for (int k=0; k<NV; k++){ d[k] = elem_[k][i]; }
+                if (order == 1) continue;
+                if (order == 2){
+                    for (int k=0; k<NE; k++){ d[NV + k] = nVertex + elem_edge[k][i]; }
+                    continue;
+                }
+                for (int k=0; k<NE; k++){
+                    index_t e = elem_edge[k][i];
+                    index_t first = nVertex + 2 * static_cast<unsigned long>(e);
+                    bool forward = elem_[Traits::edge[k][0]][i] == edge[0][e];
+                    d[NV + 2 * k] = forward ? first : first + 1;
+                    d[NV + 2 * k + 1] = forward ? first + 1 : first;
+                }
+                index_t base = nVertex + 2 * nE;
+                if constexpr (Traits::dim == 2){
+                    d[NV + 2 * NE] = base + i;
+                } else {
+                    for (int j=0; j<NS; j++){ d[NV + 2 * NE + j] = base + elem_sub_conn_[j][i]; }
+                }
+            }
+        });
+    }
+}
+
+
+template <class Traits>
+void Mesh<Traits>::vertex_pattern(SparsityPattern &pattern){
+    ScopedPhase phase(stats_.get(), "vertex_pattern", arena_);
+    pattern.template build_vertex<NV>(nVertex, nElement, elem_, resolve_threads(nThreads));
+}
+
+
+template <class Traits>
+void Mesh<Traits>::element_pattern(SparsityPattern &pattern){
+    ScopedPhase phase(stats_.get(), "element_pattern", arena_);
+    if (nSub == 0 && nElement != 0){ collect_sub_entities(); }
+    pattern.template build_element<NS>(nElement, nSub, elem_sub_conn_, sub_[SV], sub_[SV + 1],
+                                       resolve_threads(nThreads));
+}
+
+
+template <class Traits>
+void Mesh<Traits>::collect_sub_entities(){
+    ScopedPhase phase(stats_.get(), "collect_sub_entities", arena_);
+    release_sub();
+    TopologyResult<NS, SV> topo;
+    collect_topology(nVertex, nElement, elem_, Traits::local, resolve_threads(nThreads), topo, arena_);
+    take_topology(topo);
+}
+
+
+template <class Traits>
+void Mesh<Traits>::collect_sub_entities_out_of_core(const std::string &off_path, const std::string &snapshot_path,
+                                                    size_t memory_budget, const std::string &scratch_dir){
+    collect_topology_out_of_core<NV>(off_path, snapshot_path, Traits::local, Traits::snapshot_type,
+                                     memory_budget, scratch_dir);
+}
+
+
+template <class Traits>
+void Mesh<Traits>::element_vector_area(double *const *normal, double *area){
+    unsigned nthreads = resolve_threads(nThreads);
+    if constexpr (NV == 3){
+        triangle_normals(nElement, x_, y_, z_, elem_, normal, area, nthreads);
+    } else {
+        // 多边形按顶点0做扇形剖分，累加各三角形的面积向量
+        parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned){
+            for (unsigned long i = lo; i < hi; ++i){
+                double p[NV][3];
+                for (int k=0; k<NV; k++){
+                    p[k][0] = x_[elem_[k][i]]; p[k][1] = y_[elem_[k][i]]; p[k][2] = z_[elem_[k][i]];
+                }
+                double c[3] = {0, 0, 0};
+                for (int k=1; k+1<NV; k++){
+                    double u[3] = {p[k][0]-p[0][0], p[k][1]-p[0][1], p[k][2]-p[0][2]};
+                    double v[3] = {p[k+1][0]-p[0][0], p[k+1][1]-p[0][1], p[k+1][2]-p[0][2]};
+                    c[0] += u[1]*v[2] - u[2]*v[1];
+                    c[1] += u[2]*v[0] - u[0]*v[2];
+                    c[2] += u[0]*v[1] - u[1]*v[0];
+                }
+                double len = std::sqrt(c[0]*c[0] + c[1]*c[1] + c[2]*c[2]);
+                double inv = len > 0 ? 1.0 / len : 0.0;
+                for (int d=0; d<3; d++){ normal[d][i] = c[d] * inv; }
+                area[i] = 0.5 * len;
+            }
+        });
+    }
+}
+
+
+template <class Traits>
+void Mesh<Traits>::element_volume(double *volume){
+    unsigned nthreads = resolve_threads(nThreads);
+    if constexpr (NV == 4){
+        tetrahedron_volumes(nElement, x_, y_, z_, elem_, volume, nthreads);
+    } else {
+        // 散度定理：各面（法向朝外）按扇形剖分，以顶点0为锥顶累加有向四面体体积
+        parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned){
+            for (unsigned long i = lo; i < hi; ++i){
+                double p[NV][3];
+                for (int k=0; k<NV; k++){
+                    p[k][0] = x_[elem_[k][i]] - x_[elem_[0][i]];
+                    p[k][1] = y_[elem_[k][i]] - y_[elem_[0][i]];
+                    p[k][2] = z_[elem_[k][i]] - z_[elem_[0][i]];
+                }
+                double v = 0;
+                for (int j=0; j<NS; j++){
+                    const double *a = p[Traits::local[j][0]];
+                    for (int k=1; k+1<SV; k++){
+                        const double *b = p[Traits::local[j][k]], *c = p[Traits::local[j][k+1]];
+                        v += a[0]*(b[1]*c[2] - b[2]*c[1]) + a[1]*(b[2]*c[0] - b[0]*c[2]) + a[2]*(b[0]*c[1] - b[1]*c[0]);
+                    }
+                }
+                volume[i] = v / 6;
+            }
+        });
+    }
+}
+
+
+template <class Traits>
+void Mesh<Traits>::compute_geometry(){
+    ScopedPhase phase(stats_.get(), "compute_geometry", arena_);
+    unsigned nthreads = resolve_threads(nThreads);
+    if (elem_measure_ == nullptr){
+        for (int i=0; i<3; i++){ elem_centroid_[i] = arena_.template allocate<double>(nElement); }
+        if (Traits::dim == 2){
+            for (int i=0; i<3; i++){ elem_normal_[i] = arena_.template allocate<double>(nElement); }
+        }
+        elem_measure_ = arena_.template allocate<double>(nElement);
+    }
+
+    if constexpr (NV == 3 || NV == 4){
+        element_centroids(nElement, NV, x_, y_, z_, elem_, elem_centroid_, nthreads);
+    } else {
+        parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned){
+            for (unsigned long i = lo; i < hi; ++i){
+                double c[3] = {0, 0, 0};
+                for (int k=0; k<NV; k++){ c[0] += x_[elem_[k][i]]; c[1] += y_[elem_[k][i]]; c[2] += z_[elem_[k][i]]; }
+                for (int d=0; d<3; d++){ elem_centroid_[d][i] = c[d] / NV; }
+            }
+        });
+    }
+
+    if constexpr (Traits::dim == 2){
+        element_vector_area(elem_normal_, elem_measure_);
+        return;
+    }
+    element_volume(elem_measure_);
+
+    if (nSub == 0) return;
+    if (sub_area_ == nullptr){
+        for (int i=0; i<3; i++){ sub_normal_[i] = arena_.template allocate<double>(nSub); }
+        sub_area_ = arena_.template allocate<double>(nSub);
+    }
+    if constexpr (SV == 3){
+        face_normals(nSub, x_, y_, z_, sub_, sub_[SV], elem_centroid_, sub_normal_, sub_area_, nthreads);
+    } else {
+        // 子实体表中的顶点是排序过的，按左侧单元中的局部面表取得环绕顺序
+        parallel_for(0, nSub, nthreads, [&](unsigned long lo, unsigned long hi, unsigned){
+            for (unsigned long f = lo; f < hi; ++f){
+                unsigned long e = sub_[SV][f];
+                int j = static_cast<int>(std::min<unsigned long>(sub_order_[0][f], NS - 1));
+                double p[SV][3], fc[3] = {0, 0, 0};
+                for (int k=0; k<SV; k++){
+                    unsigned long v = elem_[Traits::local[j][k]][e];
+                    p[k][0] = x_[v]; p[k][1] = y_[v]; p[k][2] = z_[v];
+                    for (int d=0; d<3; d++){ fc[d] += p[k][d] / SV; }
+                }
+                double c[3] = {0, 0, 0};
+                for (int k=1; k+1<SV; k++){
+                    double u[3] = {p[k][0]-p[0][0], p[k][1]-p[0][1], p[k][2]-p[0][2]};
+                    double v[3] = {p[k+1][0]-p[0][0], p[k+1][1]-p[0][1], p[k+1][2]-p[0][2]};
+                    c[0] += u[1]*v[2] - u[2]*v[1];
+                    c[1] += u[2]*v[0] - u[0]*v[2];
+                    c[2] += u[0]*v[1] - u[1]*v[0];
+                }
+                double s = 0;
+                for (int d=0; d<3; d++){ s += c[d] * (fc[d] - elem_centroid_[d][e]); }
+                double len = std::sqrt(c[0]*c[0] + c[1]*c[1] + c[2]*c[2]);
+                double inv = len > 0 ? (s < 0 ? -1.0 : 1.0) / len : 0.0;
+                for (int d=0; d<3; d++){ sub_normal_[d][f] = c[d] * inv; }
+                sub_area_[f] = 0.5 * len;
+            }
+        });
+    }
+}
+
+
+template <class Traits>
+unsigned long Mesh<Traits>::fix_orientation(){
+    ScopedPhase phase(stats_.get(), "fix_orientation", arena_);
+    unsigned nthreads = resolve_threads(nThreads);
+    std::vector<unsigned char> flip(nElement, 0);
+
+    if constexpr (Traits::dim == 3){
+        std::vector<double> volume(nElement);
+        element_volume(volume.data());
+        parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned){
+            for (unsigned long i = lo; i < hi; ++i){ flip[i] = volume[i] < 0; }
+        });
+    } else {
+        // 曲面单元的朝向沿边逐个传播，每个连通分量内是一次串行的广度优先遍历（并行的只有前面的边提取
+        // 和单元法向量计算，以及最后的翻转）：传播依赖已访问单元的结果，按单元独立并行的做法不适用
+        // 未提取边时临时提取
+        TopologyResult<NS, SV> topo;
+        bool own = nSub == 0;
+        if (own){
+            collect_topology(nVertex, nElement, elem_, Traits::local, nthreads, topo, arena_);
+        } else {
+            for (int i=0; i<SV+2; i++){ topo.entity[i] = sub_[i]; }
+            for (int i=0; i<NS; i++){ topo.conn[i] = elem_sub_conn_[i]; }
+            topo.order[0] = sub_order_[0];
+            topo.order[1] = sub_order_[1];
+        }
+        const index_t *left = topo.entity[SV], *right = topo.entity[SV + 1];
+
+        std::vector<double> nbuf(3 * nElement), area(nElement);
+        double *normal[3] = {nbuf.data(), nbuf.data() + nElement, nbuf.data() + 2 * nElement};
+        element_vector_area(normal, area.data());
+
+        std::vector<unsigned char> visited(nElement, 0);
+        std::vector<unsigned long> queue;
+        queue.reserve(nElement);
+        for (unsigned long seed = 0; seed < nElement; ++seed){
+            if (visited[seed]) continue;
+            unsigned long head = queue.size();
+            queue.push_back(seed);
+            visited[seed] = 1;
+            bool closed = true;
+            double volume = 0, projected = 0;
+            for (unsigned long q = head; q < queue.size(); ++q){
+                unsigned long t = queue[q];
+                double sign = flip[t] ? -1.0 : 1.0;
+                double c[3] = {0, 0, 0};
+                for (int k=0; k<NV; k++){ c[0] += x_[elem_[k][t]]; c[1] += y_[elem_[k][t]]; c[2] += z_[elem_[k][t]]; }
+                volume += sign * area[t] * (c[0] * normal[0][t] + c[1] * normal[1][t] + c[2] * normal[2][t]) / (3 * NV);
+                projected += sign * area[t] * normal[2][t];
+                for (int j=0; j<NS; j++){
+                    unsigned long e = topo.conn[j][t];
+                    if (right[e] > nElement){ closed = false; continue; }
+                    unsigned long u = left[e] == t ? right[e] : left[e];
+                    if (u == t || visited[u]) continue;
+                    unsigned long ju = left[e] == u ? topo.order[0][e] : topo.order[1][e];
+                    // 两个单元沿公共边的走向相同则朝向相反
+                    bool same = elem_[Traits::local[ju][0]][u] == elem_[Traits::local[j][0]][t];
+                    flip[u] = flip[t] ^ (same ? 1 : 0);
+                    visited[u] = 1;
+                    queue.push_back(u);
+                }
+            }
+            if ((closed ? volume : projected) < 0){
+                for (unsigned long q = head; q < queue.size(); ++q){ flip[queue[q]] ^= 1; }
+            }
+        }
+        if (own){
+            for (int i=0; i<SV+2; i++){ arena_.release(topo.entity[i]); }
+            for (int i=0; i<NS; i++){ arena_.release(topo.conn[i]); }
+            arena_.release(topo.order[0]);
+            arena_.release(topo.order[1]);
+            arena_.release(topo.boundary);
+        }
+    }
+
+    std::vector<unsigned long> count(nthreads, 0);
+    parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned tid){
+        for (unsigned long i = lo; i < hi; ++i){
+            if (flip[i]){
+                reflect_element(i);
+                ++count[tid];
+            }
+        }
+    });
+    unsigned long flipped = 0;
+    for (unsigned long c : count){ flipped += c; }
+
+    // 翻转改变了子实体在单元中的局部序号，已有的拓扑和几何量重新计算
+    if (flipped != 0){
+        if (nSub != 0){ collect_sub_entities(); }
+        if (nEdge != 0){ collect_mesh_edges(); }
+        if (vtx_elem_offset_ != nullptr){ build_adjacency(); }
+        if (elem_measure_ != nullptr){ compute_geometry(); }
+    }
+    return flipped;
+}
+
+
+template <class Traits>
+void Mesh<Traits>::reorder(ReorderMethod method, unsigned long *vertex_perm, unsigned long *elem_perm,
+                           unsigned long *sub_perm){
+    ScopedPhase phase(stats_.get(), "reorder", arena_);
+    unsigned nthreads = resolve_threads(nThreads);
+    bool had_geometry = elem_measure_ != nullptr;
+    bool had_coloring = color_offset_ != nullptr;
+    bool had_edges = edge_[0] != nullptr;
+    release_edges();
+    std::vector<unsigned long> vperm(nVertex), eperm(nElement), vinv(nVertex);
+    compute_ordering<NV>(method, nVertex, nElement, x_, y_, z_, elem_, nthreads, vperm.data(), eperm.data());
+    for (unsigned long k = 0; k < nVertex; ++k){ vinv[vperm[k]] = k; }
+
+    double **coord[3] = {&x_, &y_, &z_};
+    for (int d = 0; d < 3; d++){
+        double *c = permuted_array(*coord[d], nVertex, vperm.data(), nthreads, arena_);
+        release_array(*coord[d]);
+        *coord[d] = c;
+    }
+    index_t *elem[NV];
+    permuted_elements<NV>(elem_, nElement, eperm.data(), vinv.data(), nthreads, elem, arena_);
+    for (int j = 0; j < NV; j++){
+        release_array(elem_[j]);
+        elem_[j] = elem[j];
+    }
+
+    if (nSub != 0){
+        TopologyResult<NS, SV> topo;
+        permute_topology<NS, SV>(nElement, nSub, eperm.data(), vinv.data(), sub_, elem_sub_conn_,
+                                 nthreads, topo, sub_perm, arena_);
+        release_sub();
+        take_topology(topo);
+    }
+    if (vtx_elem_offset_ != nullptr){ build_adjacency(); }
+    if (had_geometry){ compute_geometry(); }
+    if (had_coloring){ build_sub_coloring(); }
+    if (had_edges){ collect_mesh_edges(); }
+
+    if (vertex_perm != nullptr){ std::copy(vperm.begin(), vperm.end(), vertex_perm); }
+    if (elem_perm != nullptr){ std::copy(eperm.begin(), eperm.end(), elem_perm); }
+}
+
+
+template <class Traits>
+void Mesh<Traits>::begin_edit(){
+    if (edit_) return;
+    if (nSub == 0 && nElement != 0){ collect_sub_entities(); }
+    release_adjacency();
+    release_geometry();
+    release_coloring();
+    release_edges();
+    edit_.reset(new MeshEditState);
+    MeshEditState &ed = *edit_;
+    ed.vertex_elements.resize(nVertex);
+    for (unsigned long i = 0; i < nElement; ++i){
+        for (int j=0; j<NV; j++){ ed.vertex_elements[elem_[j][i]].push_back(i); }
+    }
+    ed.cap_vertex = nVertex;
+    ed.cap_element = nElement;
+    ed.cap_sub = nSub;
+}
+
+
+// 提交后的第一次修改：边界子实体的第二个单元改回edit_none，子实体着色和棱表失效
+template <class Traits>
+void Mesh<Traits>::edit_resume(){
+    if (!edit_){
+        throw MeshError("Mesh is not being edited, call begin_edit first!");
+    }
+    if (!edit_->committed) return;
+    for (unsigned long b = 0; b < nBoundary; ++b){ sub_[SV + 1][boundary_[b]] = edit_none; }
+    release_coloring();
+    release_edges();
+    edit_->committed = false;
+}
+
+
+template <class Traits>
+void Mesh<Traits>::reserve_vertices(unsigned long n){
+    MeshEditState &ed = *edit_;
+    if (n <= ed.cap_vertex) return;
+    check_index_range(n, "vertices");
+    unsigned long cap = std::max(n, 2 * ed.cap_vertex);
+    resize_array(x_, nVertex, cap);
+    resize_array(y_, nVertex, cap);
+    resize_array(z_, nVertex, cap);
+    ed.cap_vertex = cap;
+}
+
+
+template <class Traits>
+void Mesh<Traits>::reserve_elements(unsigned long n){
+    MeshEditState &ed = *edit_;
+    if (n <= ed.cap_element) return;
+    check_index_range(n, "elements");
+    unsigned long cap = std::max(n, 2 * ed.cap_element);
+    for (int j=0; j<NV; j++){ resize_array(elem_[j], nElement, cap); }
+    for (int j=0; j<NS; j++){ resize_array(elem_sub_conn_[j], nElement, cap); }
+    ed.cap_element = cap;
+}
+
+
+template <class Traits>
+void Mesh<Traits>::reserve_subs(unsigned long n){
+    MeshEditState &ed = *edit_;
+    if (n <= ed.cap_sub) return;
+    check_index_range(n, "sub-entities");
+    unsigned long cap = std::max(n, 2 * ed.cap_sub);
+    for (int a=0; a<SV+2; a++){ resize_array(sub_[a], nSub, cap); }
+    for (int a=0; a<2; a++){ resize_array(sub_order_[a], nSub, cap); }
+    ed.cap_sub = cap;
+}
+
+
+// 按排序后的顶点查找子实体：只需检查包含其中某个顶点的单元（取单元最少的顶点），不存在时返回edit_none
+template <class Traits>
+index_t Mesh<Traits>::find_sub(const index_t *key){
+    const std::vector<index_t> *ve = &edit_->vertex_elements[key[0]];
+    for (int a=1; a<SV; a++){
+        const std::vector<index_t> &va = edit_->vertex_elements[key[a]];
+        if (va.size() < ve->size()){ ve = &va; }
+    }
+    for (index_t e : *ve){
+        for (int j=0; j<NS; j++){
+            index_t s = elem_sub_conn_[j][e];
+            bool same = true;
+            for (int a=0; a<SV; a++){
+                if (sub_[a][s] != key[a]){ same = false; break; }
+            }
+            if (same) return s;
+        }
+    }
+    return edit_none;
+}
+
+
+template <class Traits>
+index_t Mesh<Traits>::insert_element(const index_t *v){
+    MeshEditState &ed = *edit_;
+    for (int j=0; j<NV; j++){
+        if (v[j] >= nVertex){
+            throw MeshError(error_message("Vertex index out of range: ", v[j]));
+        }
+        for (int k=0; k<j; k++){
+            if (v[k] == v[j]){
+                throw MeshError(error_message("Element has repeated vertex: ", v[j]));
+            }
+        }
+    }
+    // 先查出全部子实体并检查，出错时网格保持不变
+    index_t key[NS][SV], found[NS];
+    for (int j=0; j<NS; j++){
+        for (int a=0; a<SV; a++){ key[j][a] = v[Traits::local[j][a]]; }
+        detail::sort_key<SV>(key[j]);
+        found[j] = find_sub(key[j]);
+        if (found[j] != edit_none && sub_[SV + 1][found[j]] != edit_none){
+            throw MeshError("Sub-entity would be shared by more than two elements!");
+        }
+    }
+
+    reserve_elements(nElement + 1);
+    index_t i = nElement++;
+    for (int j=0; j<NV; j++){ elem_[j][i] = v[j]; }
+    for (int j=0; j<NS; j++){
+        index_t s = found[j];
+        if (s != edit_none){
+            sub_[SV + 1][s] = i;
+            sub_order_[1][s] = j;
+        } else {
+            reserve_subs(nSub + 1);
+            s = nSub++;
+            for (int a=0; a<SV; a++){ sub_[a][s] = key[j][a]; }
+            sub_[SV][s] = i;
+            sub_[SV + 1][s] = edit_none;
+            sub_order_[0][s] = j;
+            sub_order_[1][s] = NS;
+        }
+        elem_sub_conn_[j][i] = s;
+        ed.dirty_sub.push_back(s);
+    }
+    for (int j=0; j<NV; j++){ ed.vertex_elements[v[j]].push_back(i); }
+    ed.dirty_element.push_back(i);
+    return i;
+}
+
+
+// 删除没有单元的子实体，最后一个子实体移到它的位置
+template <class Traits>
+void Mesh<Traits>::erase_sub(index_t s){
+    index_t last = nSub - 1;
+    if (s != last){
+        for (int a=0; a<SV+2; a++){ sub_[a][s] = sub_[a][last]; }
+        for (int a=0; a<2; a++){ sub_order_[a][s] = sub_order_[a][last]; }
+        elem_sub_conn_[sub_order_[0][s]][sub_[SV][s]] = s;
+        if (sub_[SV + 1][s] != edit_none){ elem_sub_conn_[sub_order_[1][s]][sub_[SV + 1][s]] = s; }
+        edit_->dirty_sub.push_back(s);
+    }
+    --nSub;
+}
+
+
+// 删除单元i，最后一个单元移到它的位置
+template <class Traits>
+void Mesh<Traits>::erase_element(index_t i){
+    MeshEditState &ed = *edit_;
+    for (int j=0; j<NS; j++){
+        index_t s = elem_sub_conn_[j][i];
+        if (sub_[SV][s] == i){
+            if (sub_[SV + 1][s] == edit_none){
+                erase_sub(s);
+                continue;
+            }
+            // 剩下的单元成为左侧单元
+            sub_[SV][s] = sub_[SV + 1][s];
+            sub_order_[0][s] = sub_order_[1][s];
+        }
+        sub_[SV + 1][s] = edit_none;
+        sub_order_[1][s] = NS;
+        ed.dirty_sub.push_back(s);
+    }
+    for (int j=0; j<NV; j++){
+        std::vector<index_t> &ve = ed.vertex_elements[elem_[j][i]];
+        *std::find(ve.begin(), ve.end(), i) = ve.back();
+        ve.pop_back();
+    }
+
+    index_t last = nElement - 1;
+    if (i != last){
+        for (int j=0; j<NV; j++){
+            elem_[j][i] = elem_[j][last];
+            std::vector<index_t> &ve = ed.vertex_elements[elem_[j][i]];
+            *std::find(ve.begin(), ve.end(), last) = i;
+        }
+        for (int j=0; j<NS; j++){
+            index_t s = elem_sub_conn_[j][last];
+            elem_sub_conn_[j][i] = s;
+            sub_[sub_[SV][s] == last ? SV : SV + 1][s] = i;
+        }
+        ed.dirty_element.push_back(i);
+    }
+    --nElement;
+}
+
+
+// 删除一组单元（按编号从大到小，使待删除的单元不会被移动）后依次加入新单元，tuples中每NV个为一个单元
+template <class Traits>
+void Mesh<Traits>::replace_elements(std::vector<index_t> &old_elements, const std::vector<index_t> &tuples){
+    std::sort(old_elements.begin(), old_elements.end(), std::greater<index_t>());
+    for (index_t e : old_elements){ erase_element(e); }
+    for (size_t t = 0; t < tuples.size(); t += NV){ insert_element(&tuples[t]); }
+}
+
+
+template <class Traits>
+std::vector<index_t> Mesh<Traits>::elements_with_edge(index_t a, index_t b){
+    std::vector<index_t> out;
+    for (index_t e : edit_->vertex_elements[a]){
+        for (int j=0; j<NV; j++){
+            if (elem_[j][e] == b){ out.push_back(e); break; }
+        }
+    }
+    return out;
+}
+
+
+// 单纯形的朝向：四面体为6倍有向体积；三角形为法向量与ref的点积（ref为nullptr时为面积的平方的4倍）
+template <class Traits>
+double Mesh<Traits>::simplex_orientation(const index_t *v, const double *ref){
+    double p[NV][3];
+    for (int k=0; k<NV; k++){
+        p[k][0] = x_[v[k]] - x_[v[0]]; p[k][1] = y_[v[k]] - y_[v[0]]; p[k][2] = z_[v[k]] - z_[v[0]];
+    }
+    double c[3] = {p[1][1]*p[2][2] - p[1][2]*p[2][1], p[1][2]*p[2][0] - p[1][0]*p[2][2], p[1][0]*p[2][1] - p[1][1]*p[2][0]};
+    if constexpr (Traits::dim == 3){
+        return p[3][0]*c[0] + p[3][1]*c[1] + p[3][2]*c[2];
+    } else {
+        if (ref == nullptr){ ref = c; }
+        return c[0]*ref[0] + c[1]*ref[1] + c[2]*ref[2];
+    }
+}
+
+
+template <class Traits>
+index_t Mesh<Traits>::add_vertex(double x, double y, double z){
+    edit_resume();
+    reserve_vertices(nVertex + 1);
+    index_t v = nVertex++;
+    x_[v] = x; y_[v] = y; z_[v] = z;
+    edit_->vertex_elements.emplace_back();
+    edit_->dirty_vertex.push_back(v);
+    return v;
+}
+
+
+template <class Traits>
+void Mesh<Traits>::move_vertex(index_t v, double x, double y, double z){
+    edit_resume();
+    if (v >= nVertex){
+        throw MeshError(error_message("Vertex index out of range: ", v));
+    }
+    x_[v] = x; y_[v] = y; z_[v] = z;
+    edit_->dirty_vertex.push_back(v);
+    for (index_t e : edit_->vertex_elements[v]){ edit_->dirty_element.push_back(e); }
+}
+
+
+template <class Traits>
+index_t Mesh<Traits>::add_element(const index_t *v){
+    edit_resume();
+    return insert_element(v);
+}
+
+
+template <class Traits>
+void Mesh<Traits>::remove_element(index_t i){
+    edit_resume();
+    if (i >= nElement){
+        throw MeshError(error_message("Element index out of range: ", i));
+    }
+    erase_element(i);
+}
+
+
+template <class Traits>
+index_t Mesh<Traits>::split_edge(index_t a, index_t b, double x, double y, double z){
+    if (NV != Traits::dim + 1){
+        throw MeshError("split_edge requires a triangle or tetrahedron mesh!");
+    }
+    edit_resume();
+    std::vector<index_t> old = a < nVertex && b < nVertex ? elements_with_edge(a, b) : std::vector<index_t>();
+    if (old.empty()){
+        throw MeshError(error_message("No element contains edge ", a, "-", b));
+    }
+    index_t m = add_vertex(x, y, z);
+    std::vector<index_t> tuples;
+    for (index_t e : old){
+        for (index_t w : {b, a}){
+            for (int j=0; j<NV; j++){ tuples.push_back(elem_[j][e] == w ? m : elem_[j][e]); }
+        }
+    }
+    replace_elements(old, tuples);
+    return m;
+}
+
+
+template <class Traits>
+index_t Mesh<Traits>::split_element(index_t i, double x, double y, double z){
+    if (NV != Traits::dim + 1){
+        throw MeshError("split_element requires a triangle or tetrahedron mesh!");
+    }
+    edit_resume();
+    if (i >= nElement){
+        throw MeshError(error_message("Element index out of range: ", i));
+    }
+    index_t m = add_vertex(x, y, z);
+    std::vector<index_t> tuples, old(1, i);
+    for (int k=0; k<NV; k++){
+        for (int j=0; j<NV; j++){ tuples.push_back(j == k ? m : elem_[j][i]); }
+    }
+    replace_elements(old, tuples);
+    return m;
+}
+
+
+template <class Traits>
+bool Mesh<Traits>::flip_sub(index_t s){
+    if (NV != Traits::dim + 1){
+        throw MeshError("flip_sub requires a triangle or tetrahedron mesh!");
+    }
+    edit_resume();
+    if (s >= nSub || sub_[SV + 1][s] == edit_none) return false;
+    index_t L = sub_[SV][s], R = sub_[SV + 1][s];
+    // 单纯形中与第j个子实体相对的顶点：局部序号之和减去子实体的局部序号
+    auto apex = [&](index_t e, int j){
+        int k = NV * (NV - 1) / 2;
+        for (int a=0; a<SV; a++){ k -= Traits::local[j][a]; }
+        return elem_[k][e];
+    };
+    index_t d = apex(L, sub_order_[0][s]), e = apex(R, sub_order_[1][s]);
+    if (d == e) return false;
+
+    index_t vl[NV];
+    for (int j=0; j<NV; j++){ vl[j] = elem_[j][L]; }
+    double ref[3] = {0, 0, 0};
+    if constexpr (NV == 3){
+        double p[3][3];
+        for (int k=0; k<3; k++){
+            p[k][0] = x_[vl[k]] - x_[vl[0]]; p[k][1] = y_[vl[k]] - y_[vl[0]]; p[k][2] = z_[vl[k]] - z_[vl[0]];
+        }
+        ref[0] = p[1][1]*p[2][2] - p[1][2]*p[2][1];
+        ref[1] = p[1][2]*p[2][0] - p[1][0]*p[2][2];
+        ref[2] = p[1][0]*p[2][1] - p[1][1]*p[2][0];
+    }
+    double orient = simplex_orientation(vl, ref);
+
+    // 新单元：把L中子实体s的每个顶点依次换成R的对顶点e，朝向与L相同
+    std::vector<index_t> tuples;
+    for (int j=0; j<NV; j++){
+        if (vl[j] == d) continue;
+        index_t t[NV];
+        for (int k=0; k<NV; k++){ t[k] = k == j ? e : vl[k]; }
+        if (simplex_orientation(t, ref) * orient <= 0) return false;
+        // 含有d和e的子实体是新产生的，已经存在则翻转后不再是流形
+        for (int js=0; js<NS; js++){
+            index_t key[SV];
+            bool has_d = false, has_e = false;
+            for (int a=0; a<SV; a++){
+                key[a] = t[Traits::local[js][a]];
+                has_d = has_d || key[a] == d;
+                has_e = has_e || key[a] == e;
+            }
+            detail::sort_key<SV>(key);
+            if (has_d && has_e && find_sub(key) != edit_none) return false;
+        }
+        tuples.insert(tuples.end(), t, t + NV);
+    }
+    std::vector<index_t> old = {L, R};
+    replace_elements(old, tuples);
+    return true;
+}
+
+
+template <class Traits>
+bool Mesh<Traits>::collapse_edge(index_t a, index_t b){
+    if (NV != Traits::dim + 1){
+        throw MeshError("collapse_edge requires a triangle or tetrahedron mesh!");
+    }
+    edit_resume();
+    if (a >= nVertex || b >= nVertex || a == b) return false;
+    std::vector<index_t> old = elements_with_edge(a, b);
+    if (old.empty()) return false;
+
+    // 包含b但不包含a的单元，把b换成a后重新加入
+    std::vector<index_t> moved, tuples;
+    for (index_t e : edit_->vertex_elements[b]){
+        if (std::find(old.begin(), old.end(), e) != old.end()) continue;
+        moved.push_back(e);
+        index_t t[NV];
+        for (int j=0; j<NV; j++){ t[j] = elem_[j][e] == b ? a : elem_[j][e]; }
+        double ref[3] = {0, 0, 0};
+        index_t v[NV];
+        for (int j=0; j<NV; j++){ v[j] = elem_[j][e]; }
+        if constexpr (NV == 3){
+            double p[3][3];
+            for (int k=0; k<3; k++){
+                p[k][0] = x_[v[k]] - x_[v[0]]; p[k][1] = y_[v[k]] - y_[v[0]]; p[k][2] = z_[v[k]] - z_[v[0]];
+            }
+            ref[0] = p[1][1]*p[2][2] - p[1][2]*p[2][1];
+            ref[1] = p[1][2]*p[2][0] - p[1][0]*p[2][2];
+            ref[2] = p[1][0]*p[2][1] - p[1][1]*p[2][0];
+        }
+        if (simplex_orientation(t, ref) * simplex_orientation(v, ref) <= 0) return false;
+        tuples.insert(tuples.end(), t, t + NV);
+    }
+
+    // 检查收缩后每个子实体至多两个单元：删除的单元不计，新单元的子实体逐个累加
+    std::vector<index_t> removed(old);
+    removed.insert(removed.end(), moved.begin(), moved.end());
+    auto is_removed = [&](index_t e){ return std::find(removed.begin(), removed.end(), e) != removed.end(); };
+    std::vector<std::array<index_t, SV>> keys;
+    std::vector<std::array<index_t, NV>> added;
+    for (size_t t = 0; t < tuples.size(); t += NV){
+        // 新单元与保留的单元或其他新单元重复
+        std::array<index_t, NV> sorted;
+        std::copy(&tuples[t], &tuples[t] + NV, sorted.begin());
+        std::sort(sorted.begin(), sorted.end());
+        if (std::find(added.begin(), added.end(), sorted) != added.end()) return false;
+        added.push_back(sorted);
+        for (index_t e : edit_->vertex_elements[a]){
+            if (is_removed(e)) continue;
+            std::array<index_t, NV> other;
+            for (int j=0; j<NV; j++){ other[j] = elem_[j][e]; }
+            std::sort(other.begin(), other.end());
+            if (other == sorted) return false;
+        }
+        for (int js=0; js<NS; js++){
+            std::array<index_t, SV> key;
+            for (int k=0; k<SV; k++){ key[k] = tuples[t + Traits::local[js][k]]; }
+            detail::sort_key<SV>(key.data());
+            keys.push_back(key);
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    for (size_t k = 0; k < keys.size(); ){
+        size_t k1 = k;
+        while (k1 < keys.size() && keys[k1] == keys[k]){ ++k1; }
+        size_t count = k1 - k;
+        index_t s = find_sub(keys[k].data());
+        if (s != edit_none){
+            if (!is_removed(sub_[SV][s])){ ++count; }
+            if (sub_[SV + 1][s] != edit_none && !is_removed(sub_[SV + 1][s])){ ++count; }
+        }
+        if (count > 2) return false;
+        k = k1;
+    }
+
+    replace_elements(removed, tuples);
+    edit_->dirty_vertex.push_back(a);
+    return true;
+}
+
+
+// 把点from移到编号to（to处的点已不再使用），更新引用它的单元和子实体
+template <class Traits>
+void Mesh<Traits>::move_vertex_slot(index_t from, index_t to){
+    MeshEditState &ed = *edit_;
+    x_[to] = x_[from]; y_[to] = y_[from]; z_[to] = z_[from];
+    for (index_t e : ed.vertex_elements[from]){
+        for (int j=0; j<NV; j++){
+            if (elem_[j][e] == from){ elem_[j][e] = to; }
+        }
+        for (int j=0; j<NS; j++){
+            index_t s = elem_sub_conn_[j][e];
+            index_t key[SV];
+            bool hit = false;
+            for (int k=0; k<SV; k++){
+                key[k] = sub_[k][s] == from ? to : sub_[k][s];
+                hit = hit || sub_[k][s] == from;
+            }
+            if (!hit) continue;
+            detail::sort_key<SV>(key);
+            for (int k=0; k<SV; k++){ sub_[k][s] = key[k]; }
+            ed.dirty_sub.push_back(s);
+        }
+        ed.dirty_element.push_back(e);
+    }
+    ed.vertex_elements[to].swap(ed.vertex_elements[from]);
+    ed.vertex_elements[from].clear();
+    ed.dirty_vertex.push_back(to);
+}
+
+
+template <class Traits>
+void Mesh<Traits>::commit_edits(bool compact){
+    ScopedPhase phase(stats_.get(), "commit_edits", arena_);
+    if (!edit_) return;
+    MeshEditState &ed = *edit_;
+    if (compact){
+        edit_resume();
+        // 从大到小删除孤立点，最后一个点填补空位
+        for (unsigned long v = nVertex; v-- > 0; ){
+            if (!ed.vertex_elements[v].empty()) continue;
+            index_t last = nVertex - 1;
+            if (v != last){ move_vertex_slot(last, v); }
+            --nVertex;
+            ed.vertex_elements.pop_back();
+        }
+        resize_array(x_, nVertex, nVertex);
+        resize_array(y_, nVertex, nVertex);
+        resize_array(z_, nVertex, nVertex);
+        for (int j=0; j<NV; j++){ resize_array(elem_[j], nElement, nElement); }
+        for (int j=0; j<NS; j++){ resize_array(elem_sub_conn_[j], nElement, nElement); }
+        for (int a=0; a<SV+2; a++){ resize_array(sub_[a], nSub, nSub); }
+        for (int a=0; a<2; a++){ resize_array(sub_order_[a], nSub, nSub); }
+        ed.cap_vertex = nVertex;
+        ed.cap_element = nElement;
+        ed.cap_sub = nSub;
+    }
+
+    if (ed.committed) return;
+    {
+        // 边界子实体只可能是原来的边界子实体或修改过的子实体
+        std::vector<index_t> bnd(boundary_, boundary_ + nBoundary);
+        bnd.insert(bnd.end(), ed.dirty_sub.begin(), ed.dirty_sub.end());
+        std::sort(bnd.begin(), bnd.end());
+        bnd.erase(std::unique(bnd.begin(), bnd.end()), bnd.end());
+        bnd.erase(std::remove_if(bnd.begin(), bnd.end(), [&](index_t s){
+            return s >= nSub || sub_[SV + 1][s] != edit_none;
+        }), bnd.end());
+        for (index_t s : bnd){ sub_[SV + 1][s] = nElement + 1; }
+        release_array(boundary_);
+        nBoundary = bnd.size();
+        boundary_ = copy_array(bnd.data(), nBoundary);
+    }
+
+    auto settle = [](std::vector<index_t> &dirty, std::vector<index_t> &changed, unsigned long n){
+        std::sort(dirty.begin(), dirty.end());
+        dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+        dirty.erase(std::lower_bound(dirty.begin(), dirty.end(), n), dirty.end());
+        changed.swap(dirty);
+        dirty.clear();
+    };
+    settle(ed.dirty_vertex, ed.changed_vertex, nVertex);
+    settle(ed.dirty_element, ed.changed_element, nElement);
+    settle(ed.dirty_sub, ed.changed_sub, nSub);
+    ed.committed = true;
+}
+
+
+template <class Traits>
+void Mesh<Traits>::refine_uniform(Mesh &fine, index_t *element_parent, index_t *vertex_parent){
+    ScopedPhase phase(stats_.get(), "refine_uniform", arena_);
+    if constexpr (NV != Traits::dim + 1){
+        throw MeshError("Uniform refinement requires a triangle or tetrahedron mesh!");
+    } else {
+        using Template = detail::RefineTemplate<Traits>;
+        constexpr int NC = Template::nChild, NI = Template::nInner;
+        constexpr int NSC = Template::nSubChild;
+        if (&fine == this){
+            throw MeshError("Refined mesh must be a different object!");
+        }
+        commit_edits();
+        if (nSub == 0 && nElement != 0){ collect_sub_entities(); }
+        unsigned nthreads = resolve_threads(nThreads);
+
+        // 中点按边编号：三角形的边即子实体，四面体用棱表（尚未提取时先提取，保留在本网格中）
+        unsigned long nMid;
+        index_t *edge[2], *elem_edge[NE];
+        if constexpr (NV == 3){
+            nMid = nSub;
+            edge[0] = sub_[0]; edge[1] = sub_[1];
+            for (int k=0; k<NE; k++){ elem_edge[k] = elem_sub_conn_[k]; }
+        } else {
+            if (nEdge == 0 && nElement != 0){ collect_mesh_edges(); }
+            nMid = nEdge;
+            edge[0] = edge_[0]; edge[1] = edge_[1];
+            for (int k=0; k<NE; k++){ elem_edge[k] = elem_edge_conn_[k]; }
+        }
+        check_index_range(nVertex + nMid, "vertices");
+        check_index_range(NC * nElement, "elements");
+        check_index_range(NSC * nSub + NI * nElement, "sub-entities");
+
+        fine.release_all();
+        fine.nThreads = nThreads;
+        fine.nVertex = nVertex + nMid;
+        fine.nElement = NC * nElement;
+        fine.nSub = NSC * nSub + NI * nElement;
+        fine.nBoundary = NSC * nBoundary;
+        ArrayArena &fa = fine.arena_;
+        fine.x_ = fa.template allocate<double>(fine.nVertex);
+        fine.y_ = fa.template allocate<double>(fine.nVertex);
+        fine.z_ = fa.template allocate<double>(fine.nVertex);
+        for (int j=0; j<NV; j++){ fine.elem_[j] = fa.template allocate<index_t>(fine.nElement); }
+        for (int j=0; j<NS; j++){ fine.elem_sub_conn_[j] = fa.template allocate<index_t>(fine.nElement); }
+        for (int a=0; a<SV+2; a++){ fine.sub_[a] = fa.template allocate<index_t>(fine.nSub); }
+        for (int a=0; a<2; a++){ fine.sub_order_[a] = fa.template allocate<local_t>(fine.nSub); }
+        fine.boundary_ = fa.template allocate<index_t>(fine.nBoundary);
+
+        const double *coord[3] = {x_, y_, z_};
+        double *fcoord[3] = {fine.x_, fine.y_, fine.z_};
+        parallel_for(0, fine.nVertex, nthreads, [&](unsigned long lo, unsigned long hi, unsigned){
+            for (unsigned long v = lo; v < hi; ++v){
+                index_t a = v, b = v;
+                if (v >= nVertex){ a = edge[0][v - nVertex]; b = edge[1][v - nVertex]; }
+                for (int d=0; d<3; d++){ fcoord[d][v] = a == b ? coord[d][a] : 0.5 * (coord[d][a] + coord[d][b]); }
+                if (vertex_parent != nullptr){ vertex_parent[2 * v] = a; vertex_parent[2 * v + 1] = b; }
+            }
+        });
+
+        // 子单元、子单元的子实体及其两侧都按编号直接写出：父子实体f的第k个子实体为NSC*f+k，
+        // 单元i内部的第k个新子实体为NSC*nSub+NI*i+k；每个位置只由一个父单元写入，不需要加锁
+        const Template tmpl[3] = {Template(0), Template(1), Template(2)};
+        const unsigned long fne = fine.nElement;
+        parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned){
+            for (unsigned long i = lo; i < hi; ++i){
+                index_t g[NV + NE];
+                for (int j=0; j<NV; j++){ g[j] = elem_[j][i]; }
+                for (int k=0; k<NE; k++){ g[NV + k] = nVertex + elem_edge[k][i]; }
+                // 四面体内部的八面体沿最短的对角线剖分
+                int d = 0;
+                if constexpr (NV == 4){
+                    const int diag[3][2] = {{0, 5}, {1, 4}, {2, 3}};
+                    double best = 0;
+                    for (int c=0; c<3; c++){
+                        double len = 0;
+                        for (int a=0; a<3; a++){
+                            double t = fcoord[a][g[NV + diag[c][0]]] - fcoord[a][g[NV + diag[c][1]]];
+                            len += t * t;
+                        }
+                        if (c == 0 || len < best){ best = len; d = c; }
+                    }
+                }
+                const Template &t = tmpl[d];
+                for (int c=0; c<NC; c++){
+                    index_t ce = NC * i + c;
+                    for (int j=0; j<NV; j++){ fine.elem_[j][ce] = g[t.child[c][j]]; }
+                    if (element_parent != nullptr){ element_parent[ce] = i; }
+                    for (int j=0; j<NS; j++){
+                        index_t key[SV];
+                        for (int a=0; a<SV; a++){ key[a] = g[t.child[c][Traits::local[j][a]]]; }
+                        detail::sort_key<SV>(key);
+                        index_t s;
+                        bool first_side;
+                        if (t.on[c][j] >= 0){
+                            index_t f = elem_sub_conn_[t.on[c][j]][i];
+                            // 父子实体上的子实体按所含的父顶点在子实体表中的位置编号，中间的子面排最后
+                            int k = SV;
+                            if (t.corner[c][j] >= 0){
+                                for (int a=0; a<SV; a++){ if (sub_[a][f] == g[t.corner[c][j]]){ k = a; } }
+                            }
+                            s = NSC * f + k;
+                            first_side = sub_[SV][f] == i;
+                            if (first_side && sub_[SV + 1][f] >= nElement){
+                                fine.sub_[SV + 1][s] = fne + 1;
+                                fine.sub_order_[1][s] = NS;
+                            }
+                        } else {
+                            s = NSC * nSub + NI * i + t.inner[c][j];
+                            first_side = t.side[c][j] == 0;
+                        }
+                        if (first_side){
+                            for (int a=0; a<SV; a++){ fine.sub_[a][s] = key[a]; }
+                            fine.sub_[SV][s] = ce;
+                            fine.sub_order_[0][s] = j;
+                        } else {
+                            fine.sub_[SV + 1][s] = ce;
+                            fine.sub_order_[1][s] = j;
+                        }
+                        fine.elem_sub_conn_[j][ce] = s;
+                    }
+                }
+            }
+        });
+        parallel_for(0, nBoundary, nthreads, [&](unsigned long lo, unsigned long hi, unsigned){
+            for (unsigned long b = lo; b < hi; ++b){
+                for (int k=0; k<NSC; k++){ fine.boundary_[NSC * b + k] = NSC * boundary_[b] + k; }
+            }
+        });
+    }
+}
+
+
+template <class Traits>
+template <class ST>
+void Mesh<Traits>::extract_boundary(Mesh<ST> &surf, SurfaceMap &map, double feature_angle){
+    ScopedPhase phase(stats_.get(), "extract_boundary", arena_);
+    static_assert(Traits::dim == 3 && ST::dim == 2 && ST::nv == SV, "surface element must match the boundary faces");
+    constexpr int FV = ST::nv;
+    commit_edits();
+    if (nSub == 0 && nElement != 0){ collect_sub_entities(); }
+    unsigned nthreads = resolve_threads(nThreads);
+    const unsigned long nb = nBoundary;
+
+    // 曲面点：边界面上的点排序去重，曲面点的编号即在其中的位置
+    std::vector<index_t> &vv = map.vertex_volume;
+    vv.resize(FV * nb);
+    parallel_for(0, nb, nthreads, [&](unsigned long lo, unsigned long hi, unsigned){
+        for (unsigned long b = lo; b < hi; ++b){
+            for (int a=0; a<FV; a++){ vv[FV * b + a] = sub_[a][boundary_[b]]; }
+        }
+    });
+    std::sort(vv.begin(), vv.end());
+    vv.erase(std::unique(vv.begin(), vv.end()), vv.end());
+    map.face_volume.assign(boundary_, boundary_ + nb);
+    map.face_element.resize(nb);
+
+    surf.release_all();
+    surf.nThreads = nThreads;
+    surf.nVertex = vv.size();
+    surf.nElement = nb;
+    surf.x_ = surf.arena_.template allocate<double>(surf.nVertex);
+    surf.y_ = surf.arena_.template allocate<double>(surf.nVertex);
+    surf.z_ = surf.arena_.template allocate<double>(surf.nVertex);
+    for (int k=0; k<FV; k++){ surf.elem_[k] = surf.arena_.template allocate<index_t>(nb); }
+    parallel_for(0, surf.nVertex, nthreads, [&](unsigned long lo, unsigned long hi, unsigned){
+        for (unsigned long v = lo; v < hi; ++v){
+            surf.x_[v] = x_[vv[v]]; surf.y_[v] = y_[vv[v]]; surf.z_[v] = z_[vv[v]];
+        }
+    });
+
+    // 面按所在体单元中的环绕顺序取得顶点，法向量指向该单元的形心时反向，使曲面的法向量朝外
+    parallel_for(0, nb, nthreads, [&](unsigned long lo, unsigned long hi, unsigned){
+        for (unsigned long b = lo; b < hi; ++b){
+            index_t f = boundary_[b], e = sub_[SV][f];
+            int j = sub_order_[0][f];
+            index_t v[FV];
+            double p[FV][3], fc[3] = {0, 0, 0}, ec[3] = {0, 0, 0};
+            for (int k=0; k<FV; k++){
+                v[k] = elem_[Traits::local[j][k]][e];
+                p[k][0] = x_[v[k]]; p[k][1] = y_[v[k]]; p[k][2] = z_[v[k]];
+                for (int d=0; d<3; d++){ fc[d] += p[k][d] / FV; }
+            }
+            for (int k=0; k<NV; k++){
+                ec[0] += x_[elem_[k][e]] / NV; ec[1] += y_[elem_[k][e]] / NV; ec[2] += z_[elem_[k][e]] / NV;
+            }
+            double c[3] = {0, 0, 0};
+            for (int k=1; k+1<FV; k++){
+                double u[3] = {p[k][0]-p[0][0], p[k][1]-p[0][1], p[k][2]-p[0][2]};
+                double w[3] = {p[k+1][0]-p[0][0], p[k+1][1]-p[0][1], p[k+1][2]-p[0][2]};
+                c[0] += u[1]*w[2] - u[2]*w[1];
+                c[1] += u[2]*w[0] - u[0]*w[2];
+                c[2] += u[0]*w[1] - u[1]*w[0];
+            }
+            bool inward = c[0]*(fc[0]-ec[0]) + c[1]*(fc[1]-ec[1]) + c[2]*(fc[2]-ec[2]) < 0;
+            for (int k=0; k<FV; k++){
+                index_t g = v[inward ? ST::reflect[k] : k];
+                surf.elem_[k][b] = std::lower_bound(vv.begin(), vv.end(), g) - vv.begin();
+            }
+            map.face_element[b] = e;
+        }
+    });
+    surf.collect_sub_entities();
+
+    map.patch.clear();
+    map.nPatch = 0;
+    if (feature_angle < 0) return;
+    // 面片：相邻两面的法向量夹角不超过feature_angle（度）时属于同一面片，按面的编号顺序广度优先编号
+    std::vector<double> nbuf(3 * nb), area(nb);
+    double *normal[3] = {nbuf.data(), nbuf.data() + nb, nbuf.data() + 2 * nb};
+    surf.element_vector_area(normal, area.data());
+    const double cos_limit = std::cos(feature_angle * std::acos(-1.0) / 180);
+    const index_t none = std::numeric_limits<index_t>::max();
+    map.patch.assign(nb, none);
+    std::vector<index_t> queue;
+    queue.reserve(nb);
+    for (unsigned long seed = 0; seed < nb; ++seed){
+        if (map.patch[seed] != none) continue;
+        index_t id = map.nPatch++;
+        queue.clear();
+        queue.push_back(seed);
+        map.patch[seed] = id;
+        for (size_t q = 0; q < queue.size(); ++q){
+            index_t t = queue[q];
+            for (int j=0; j<ST::ns; j++){
+                index_t s = surf.elem_sub_conn_[j][t];
+                index_t u = surf.sub_[ST::sv][s] == t ? surf.sub_[ST::sv + 1][s] : surf.sub_[ST::sv][s];
+                if (u >= nb || map.patch[u] != none) continue;
+                double dot = normal[0][t]*normal[0][u] + normal[1][t]*normal[1][u] + normal[2][t]*normal[2][u];
+                if (dot < cos_limit) continue;
+                map.patch[u] = id;
+                queue.push_back(u);
+            }
+        }
+    }
+}
+
+
+template <class Traits>
+unsigned long Mesh<Traits>::partition(unsigned long nParts, index_t *part){
+    ScopedPhase phase(stats_.get(), "partition", arena_);
+    if (nParts == 0){
+        throw MeshError("Number of parts must be positive!");
+    }
+    check_index_range(nParts, "parts");
+    if (nSub == 0){ collect_sub_entities(); }
+    unsigned nthreads = resolve_threads(nThreads);
+    partition_rcb<NV>(nElement, x_, y_, z_, elem_, nParts, nthreads, part);
+    return count_interface(nSub, nElement, sub_[SV], sub_[SV + 1], part, nthreads);
+}
+
+
+template <class Traits>
+void Mesh<Traits>::extract_parts(const index_t *part, unsigned long nParts, Mesh *const *subs, PartMap *maps){
+    ScopedPhase phase(stats_.get(), "extract_parts", arena_);
+    if (nParts == 0){ return; }
+    for (unsigned long i = 0; i < nElement; i++){
+        if (part[i] >= nParts){
+            throw MeshError(error_message("Element ", i, " belongs to part ", part[i], ", expected less than ", nParts, "!"));
+        }
+    }
+    if (nSub == 0){ collect_sub_entities(); }
+    unsigned nthreads = resolve_threads(nThreads);
+
+    // 每个部分的自有单元（CSR的各行按单元编号升序），以及每个点所属的部分
+    ArrayArena scratch;
+    unsigned long *owned_offset;
+    index_t *owned;
+    build_csr(nParts, nElement, nthreads, [&](unsigned long i, auto &&sink){ sink(part[i], i); },
+              owned_offset, owned, scratch);
+    std::vector<index_t> vowner(nVertex, static_cast<index_t>(nParts));
+    for (unsigned long i = 0; i < nElement; i++){
+        for (int j = 0; j < NV; j++){
+            index_t &o = vowner[elem_[j][i]];
+            o = std::min(o, part[i]);
+        }
+    }
+
+    // 各部分的规模可能相差很大，线程按顺序领取部分
+    std::atomic<unsigned long> cursor(0);
+    unsigned nworkers = static_cast<unsigned>(std::min<unsigned long>(nthreads, nParts));
+    parallel_run(nworkers, [&](unsigned){
+        // 全局点 -> 局部点，每个线程一份，处理完一个部分后恢复为UNSET
+        const index_t UNSET = static_cast<index_t>(~static_cast<index_t>(0));
+        std::vector<index_t> local(nVertex, UNSET);
+        for (unsigned long p = cursor++; p < nParts; p = cursor++){
+            Mesh &sub = *subs[p];
+            PartMap &map = maps[p];
+            const index_t *own = owned + owned_offset[p];
+            unsigned long nOwn = owned_offset[p + 1] - owned_offset[p];
+
+            // 幽灵单元：经由子实体与自有单元相邻的其他部分的单元
+            std::vector<index_t> ghost;
+            for (unsigned long k = 0; k < nOwn; k++){
+                index_t e = own[k];
+                for (int j = 0; j < NS; j++){
+                    index_t f = elem_sub_conn_[j][e];
+                    index_t o = sub_[SV][f] == e ? sub_[SV + 1][f] : sub_[SV][f];
+                    if (o < nElement && part[o] != p){ ghost.push_back(o); }
+                }
+            }
+            std::sort(ghost.begin(), ghost.end());
+            ghost.erase(std::unique(ghost.begin(), ghost.end()), ghost.end());
+
+            map.part = p;
+            map.nParts = nParts;
+            map.nOwned = nOwn;
+            map.element_global.assign(own, own + nOwn);
+            map.element_global.insert(map.element_global.end(), ghost.begin(), ghost.end());
+            map.ghost_owner.resize(ghost.size());
+            for (unsigned long k = 0; k < ghost.size(); k++){ map.ghost_owner[k] = part[ghost[k]]; }
+
+            unsigned long ne = map.element_global.size();
+            std::vector<index_t> &vg = map.vertex_global;
+            vg.clear();
+            for (index_t e : map.element_global){
+                for (int j = 0; j < NV; j++){
+                    index_t v = elem_[j][e];
+                    if (local[v] == UNSET){ local[v] = 0; vg.push_back(v); }
+                }
+            }
+            std::sort(vg.begin(), vg.end());
+            unsigned long nv = vg.size();
+            map.vertex_owner.resize(nv);
+            for (unsigned long v = 0; v < nv; v++){
+                local[vg[v]] = v;
+                map.vertex_owner[v] = vowner[vg[v]];
+            }
+
+            sub.release_all();
+            sub.nVertex = nv;
+            sub.nElement = ne;
+            double *coord[3] = {x_, y_, z_};
+            double **sub_coord[3] = {&sub.x_, &sub.y_, &sub.z_};
+            for (int d = 0; d < 3; d++){
+                double *c = sub.arena_.template allocate<double>(nv);
+                for (unsigned long v = 0; v < nv; v++){ c[v] = coord[d][vg[v]]; }
+                *sub_coord[d] = c;
+            }
+            for (int j = 0; j < NV; j++){
+                sub.elem_[j] = sub.arena_.template allocate<index_t>(ne);
+                for (unsigned long k = 0; k < ne; k++){ sub.elem_[j][k] = local[elem_[j][map.element_global[k]]]; }
+            }
+            for (index_t v : vg){ local[v] = UNSET; }
+            // 子网格在各自的线程中串行提取子实体，之后沿用本网格的线程数设置
+            sub.nThreads = 1;
+            sub.collect_sub_entities();
+            sub.nThreads = nThreads;
+
+            // 单元的局部顶点顺序不变，第j个子实体与全局单元的第j个子实体相同
+            map.sub_global.resize(sub.nSub);
+            for (unsigned long k = 0; k < ne; k++){
+                for (int j = 0; j < NS; j++){
+                    map.sub_global[sub.elem_sub_conn_[j][k]] = elem_sub_conn_[j][map.element_global[k]];
+                }
+            }
+            map.interface.clear();
+            for (unsigned long f = 0; f < sub.nSub; f++){
+                index_t l = sub.sub_[SV][f], r = sub.sub_[SV + 1][f];
+                if (r < ne && (l < nOwn) != (r < nOwn)){ map.interface.push_back(f); }
+            }
+        }
+    });
+}
+
+
+template <class Traits>
+void Mesh<Traits>::write_snapshot(const std::string &path){
+    ScopedPhase phase(stats_.get(), "write_snapshot", arena_);
+    commit_edits();
+    SnapshotHeader header;
+    header.index_bytes = sizeof(index_t);
+    header.element_type = Traits::snapshot_type;
+    header.nVertex = nVertex;
+    header.nElement = nElement;
+    header.nSub = nSub;
+    header.nBoundary = nBoundary;
+
+    std::vector<SnapshotArray> arrays;
+    const double *coord[3] = {x_, y_, z_};
+    for (int d = 0; d < 3; d++){ arrays.push_back({coord[d], nVertex * sizeof(double)}); }
+    for (int i = 0; i < NV; i++){ arrays.push_back({elem_[i], nElement * sizeof(index_t)}); }
+    if (nSub != 0){
+        for (int i = 0; i < SV + 2; i++){ arrays.push_back({sub_[i], nSub * sizeof(index_t)}); }
+        for (int i = 0; i < NS; i++){ arrays.push_back({elem_sub_conn_[i], nElement * sizeof(index_t)}); }
+        for (int i = 0; i < 2; i++){ arrays.push_back({sub_order_[i], nSub * sizeof(local_t)}); }
+        arrays.push_back({boundary_, nBoundary * sizeof(index_t)});
+    }
+    write_snapshot_file(path, header, arrays);
+}
+
+
+template <class Traits>
+void Mesh<Traits>::read_snapshot(const std::string &path){
+    ScopedPhase phase(stats_.get(), "read_snapshot", arena_);
+    release_all();
+    const SnapshotHeader &h = snapshot_.open(path, Traits::snapshot_type);
+    nVertex = h.nVertex;
+    nElement = h.nElement;
+    unsigned long a = 0;
+    x_ = snapshot_.template array<double>(a++, nVertex);
+    y_ = snapshot_.template array<double>(a++, nVertex);
+    z_ = snapshot_.template array<double>(a++, nVertex);
+    for (int i = 0; i < NV; i++){ elem_[i] = snapshot_.template array<index_t>(a++, nElement); }
+    if (h.nSub != 0){
+        for (int i = 0; i < SV + 2; i++){ sub_[i] = snapshot_.template array<index_t>(a++, h.nSub); }
+        for (int i = 0; i < NS; i++){ elem_sub_conn_[i] = snapshot_.template array<index_t>(a++, nElement); }
+        for (int i = 0; i < 2; i++){ sub_order_[i] = snapshot_.template array<local_t>(a++, h.nSub); }
+        boundary_ = snapshot_.template array<index_t>(a++, h.nBoundary);
+        nSub = h.nSub;
+        nBoundary = h.nBoundary;
+    }
+}
+
+
+template <class Traits>
+void Mesh<Traits>::outputTecPlotDataFile(const char *fname, const std::vector<MeshField> &vertex_fields,
+                                         const std::vector<MeshField> &cell_fields){
+    ScopedPhase phase(stats_.get(), "outputTecPlotDataFile", arena_);
+    write_tecplot(fname, Traits::title, Traits::tecplot_zone, nVertex, nElement, x_, y_, z_, elem_, NV,
+                  vertex_fields, cell_fields);
+}
+
+
+template <class Traits>
+void Mesh<Traits>::outputVTUFile(const char *fname, const std::vector<MeshField> &vertex_fields,
+                                 const std::vector<MeshField> &cell_fields){
+    ScopedPhase phase(stats_.get(), "outputVTUFile", arena_);
+    write_vtu(fname, nVertex, nElement, x_, y_, z_, elem_, NV, Traits::vtk_type, vertex_fields, cell_fields);
+}
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_MESH_IMPL_H
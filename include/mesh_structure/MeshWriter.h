@@ -0,0 +1,231 @@
+#ifndef MESH_STRUCTURE_MESH_WRITER_H
+#define MESH_STRUCTURE_MESH_WRITER_H
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "mesh_structure/Error.h"
+#include "mesh_structure/Index.h"
+
+namespace mesh_structure {
+
+// 输出的场数据：每个点或每个单元一个值
+struct MeshField {
+    std::string name;
+    const double *data;
+};
+
+// 带大缓冲区的文件写入器：数字用std::to_chars直接格式化到缓冲区，缓冲区满时才写文件
+class BufferedWriter {
+public:
+    explicit BufferedWriter(const std::string &path, size_t capacity = 1 << 22)
+        : file_(std::fopen(path.c_str(), "wb")), buf_(capacity), pos_(0), path_(path) {
+        if (file_ == nullptr) {
+            throw FileError(path, "Cannot open output file");
+        }
+    }
+
+    ~BufferedWriter() {
+        if (file_ != nullptr) std::fclose(file_);
+    }
+
+    BufferedWriter(const BufferedWriter &) = delete;
+    BufferedWriter &operator=(const BufferedWriter &) = delete;
+
+    void put(char c) {
+        reserve(1);
+        buf_[pos_++] = c;
+    }
+
+    void put(const char *s) { put(s, std::strlen(s)); }
+    void put(const std::string &s) { put(s.data(), s.size()); }
+
+    void put(const char *s, size_t n) {
+        if (n > buf_.size()) {
+            flush();
+            write(s, n);
+            return;
+        }
+        reserve(n);
+        std::memcpy(buf_.data() + pos_, s, n);
+        pos_ += n;
+    }
+
+    // 最短的可精确还原的十进制表示
+    void put(double v) {
+        reserve(32);
+        pos_ = std::to_chars(buf_.data() + pos_, buf_.data() + buf_.size(), v).ptr - buf_.data();
+    }
+
+    void put(unsigned long v) {
+        reserve(24);
+        pos_ = std::to_chars(buf_.data() + pos_, buf_.data() + buf_.size(), v).ptr - buf_.data();
+    }
+
+    // 原样写出二进制数据
+    void put_raw(const void *p, size_t n) { put(static_cast<const char *>(p), n); }
+
+    void close() {
+        flush();
+        bool ok = std::fclose(file_) == 0;
+        file_ = nullptr;
+        if (!ok) fail();
+    }
+
+private:
+    void reserve(size_t n) {
+        if (pos_ + n > buf_.size()) flush();
+    }
+
+    void flush() {
+        write(buf_.data(), pos_);
+        pos_ = 0;
+    }
+
+    void write(const char *p, size_t n) {
+        if (n > 0 && std::fwrite(p, 1, n, file_) != n) fail();
+    }
+
+    void fail() {
+        throw FileError(path_, "Failed to write output file");
+    }
+
+    FILE *file_;
+    std::vector<char> buf_;
+    size_t pos_;
+    std::string path_;
+};
+
+
+// Tecplot ASCII有限元格式，单元编号从1开始
+// 没有单元场时用FEPOINT（逐点交错），否则用BLOCK格式并把单元场声明为CELLCENTERED
+inline void write_tecplot(const std::string &path, const char *title, const char *zone_type,
+                          unsigned long nVertex, unsigned long nElement, const double *x, const double *y,
+                          const double *z, index_t *const *elem, int nv,
+                          const std::vector<MeshField> &vertex_fields, const std::vector<MeshField> &cell_fields) {
+    BufferedWriter out(path);
+    out.put("TITLE=\"");
+    out.put(title);
+    out.put("\"\nVARIABLES= \"x\" \"y\" \"z\"");
+    for (const MeshField &f : vertex_fields) { out.put(" \""); out.put(f.name); out.put('"'); }
+    for (const MeshField &f : cell_fields) { out.put(" \""); out.put(f.name); out.put('"'); }
+    out.put("\nZONE T=\"none\", N=");
+    out.put(nVertex);
+    out.put(", E=");
+    out.put(nElement);
+    out.put(", ZONETYPE=FE");
+    out.put(zone_type);
+
+    const double *coord[3] = {x, y, z};
+    if (cell_fields.empty()) {
+        out.put(", DATAPACKING=POINT\n");
+        for (unsigned long i = 0; i < nVertex; ++i) {
+            out.put(x[i]); out.put(' ');
+            out.put(y[i]); out.put(' ');
+            out.put(z[i]);
+            for (const MeshField &f : vertex_fields) { out.put(' '); out.put(f.data[i]); }
+            out.put('\n');
+        }
+    } else {
+        unsigned long first = 4 + vertex_fields.size(), last = first + cell_fields.size() - 1;
+        out.put(", DATAPACKING=BLOCK, VARLOCATION=([");
+        out.put(first);
+        if (last > first) { out.put('-'); out.put(last); }
+        out.put("]=CELLCENTERED)\n");
+        auto block = [&](const double *v, unsigned long n) {
+            for (unsigned long i = 0; i < n; ++i) {
+                out.put(v[i]);
+                out.put((i % 8 == 7 || i + 1 == n) ? '\n' : ' ');
+            }
+        };
+        for (int d = 0; d < 3; ++d) block(coord[d], nVertex);
+        for (const MeshField &f : vertex_fields) block(f.data, nVertex);
+        for (const MeshField &f : cell_fields) block(f.data, nElement);
+    }
+
+    for (unsigned long i = 0; i < nElement; ++i) {
+        for (int j = 0; j < nv; ++j) {
+            out.put(static_cast<unsigned long>(elem[j][i]) + 1);
+            out.put(j + 1 < nv ? ' ' : '\n');
+        }
+    }
+    out.close();
+}
+
+
+// VTK XML非结构网格(.vtu)，数据以原始二进制追加在文件末尾（appended raw，UInt64长度头）
+// vtk_type: 5为三角形，10为四面体
+inline void write_vtu(const std::string &path, unsigned long nVertex, unsigned long nElement, const double *x,
+                      const double *y, const double *z, index_t *const *elem, int nv, uint8_t vtk_type,
+                      const std::vector<MeshField> &vertex_fields, const std::vector<MeshField> &cell_fields) {
+    BufferedWriter out(path);
+    uint64_t offset = 0;
+    auto data_array = [&](const char *type, const std::string &name, int ncomp, uint64_t bytes) {
+        out.put("        <DataArray type=\"");
+        out.put(type);
+        out.put("\" Name=\"");
+        out.put(name);
+        out.put("\" NumberOfComponents=\"");
+        out.put(static_cast<unsigned long>(ncomp));
+        out.put("\" format=\"appended\" offset=\"");
+        out.put(static_cast<unsigned long>(offset));
+        out.put("\"/>\n");
+        offset += sizeof(uint64_t) + bytes;
+    };
+
+    out.put("<?xml version=\"1.0\"?>\n"
+            "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n"
+            "  <UnstructuredGrid>\n    <Piece NumberOfPoints=\"");
+    out.put(nVertex);
+    out.put("\" NumberOfCells=\"");
+    out.put(nElement);
+    out.put("\">\n      <PointData>\n");
+    for (const MeshField &f : vertex_fields) data_array("Float64", f.name, 1, nVertex * sizeof(double));
+    out.put("      </PointData>\n      <CellData>\n");
+    for (const MeshField &f : cell_fields) data_array("Float64", f.name, 1, nElement * sizeof(double));
+    out.put("      </CellData>\n      <Points>\n");
+    data_array("Float64", "Points", 3, 3 * nVertex * sizeof(double));
+    out.put("      </Points>\n      <Cells>\n");
+    data_array("Int64", "connectivity", 1, nv * nElement * sizeof(int64_t));
+    data_array("Int64", "offsets", 1, nElement * sizeof(int64_t));
+    data_array("UInt8", "types", 1, nElement);
+    out.put("      </Cells>\n    </Piece>\n  </UnstructuredGrid>\n  <AppendedData encoding=\"raw\">\n_");
+
+    auto block_header = [&](uint64_t bytes) { out.put_raw(&bytes, sizeof(bytes)); };
+    for (const MeshField &f : vertex_fields) {
+        block_header(nVertex * sizeof(double));
+        out.put_raw(f.data, nVertex * sizeof(double));
+    }
+    for (const MeshField &f : cell_fields) {
+        block_header(nElement * sizeof(double));
+        out.put_raw(f.data, nElement * sizeof(double));
+    }
+    block_header(3 * nVertex * sizeof(double));
+    for (unsigned long i = 0; i < nVertex; ++i) {
+        double p[3] = {x[i], y[i], z[i]};
+        out.put_raw(p, sizeof(p));
+    }
+    block_header(nv * nElement * sizeof(int64_t));
+    for (unsigned long i = 0; i < nElement; ++i) {
+        int64_t c[8];
+        for (int j = 0; j < nv; ++j) c[j] = static_cast<int64_t>(elem[j][i]);
+        out.put_raw(c, nv * sizeof(int64_t));
+    }
+    block_header(nElement * sizeof(int64_t));
+    for (unsigned long i = 0; i < nElement; ++i) {
+        int64_t o = static_cast<int64_t>((i + 1) * nv);
+        out.put_raw(&o, sizeof(o));
+    }
+    block_header(nElement);
+    for (unsigned long i = 0; i < nElement; ++i) out.put(static_cast<char>(vtk_type));
+    out.put("\n  </AppendedData>\n</VTKFile>\n");
+    out.close();
+}
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_MESH_WRITER_H
@@ -0,0 +1,308 @@
+#ifndef MESH_STRUCTURE_OFF_READER_H
+#define MESH_STRUCTURE_OFF_READER_H
+
+#include <algorithm>
+#include <string>
+#include <cstring>
+#include <charconv>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mesh_structure/Error.h"
+#include "mesh_structure/Index.h"
+#include "mesh_structure/Parallel.h"
+
+namespace mesh_structure {
+
+// 只读内存映射文件，析构时自动解除映射
+class MappedFile {
+public:
+    explicit MappedFile(const std::string &path) : data_(nullptr), size_(0) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw FileError(path, "Wrong file name or path");
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw FileError(path, "Cannot stat file");
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ > 0) {
+            void *p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw FileError(path, "Cannot map file");
+            }
+            ::madvise(p, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char *>(p);
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (data_ != nullptr) ::munmap(const_cast<char *>(data_), size_);
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // 释放[begin, end)所在的页（只释放完整的页），用于顺序读取时限制常驻内存
+    void discard(const char *begin, const char *end) const {
+        const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        size_t lo = (begin - data_ + page - 1) / page * page, hi = (end - data_) / page * page;
+        if (hi > lo) ::madvise(const_cast<char *>(data_) + lo, hi - lo, MADV_DONTNEED);
+    }
+
+    const char *begin() const { return data_; }
+    const char *end() const { return data_ + size_; }
+    size_t size() const { return size_; }
+
+private:
+    const char *data_;
+    size_t size_;
+};
+
+
+// 在映射的缓冲区上原地扫描数字，不产生任何临时字符串
+// 记录(record)指一个非空、非注释的行；'#'到行尾为注释，兼容CRLF
+class OffScanner {
+public:
+    OffScanner(const char *begin, const char *end) : p_(begin), end_(end) {}
+
+    const char *pos() const { return p_; }
+    bool eof() const { return p_ >= end_; }
+
+    // 跳过空白行和注释，停在下一个记录的第一个字符
+    void next_record() {
+        while (p_ < end_) {
+            char c = *p_;
+            if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v') {
+                ++p_;
+            } else if (c == '#') {
+                skip_line();
+            } else {
+                return;
+            }
+        }
+    }
+
+    // 跳到下一行的开头（丢弃本行剩余内容，如颜色等附加属性）
+    void skip_line() {
+        const void *nl = std::memchr(p_, '\n', end_ - p_);
+        p_ = nl ? static_cast<const char *>(nl) + 1 : end_;
+    }
+
+    // 本行是否还有数据（遇到换行或注释视为行尾）
+    bool has_token() {
+        skip_inline_ws();
+        return p_ < end_ && *p_ != '\n' && *p_ != '#';
+    }
+
+    bool read_uint(unsigned long &v) {
+        if (!has_token()) return false;
+        if (*p_ == '+') ++p_;
+        std::from_chars_result r = std::from_chars(p_, end_, v);
+        if (r.ec != std::errc()) return false;
+        p_ = r.ptr;
+        return true;
+    }
+
+    bool read_double(double &v) {
+        if (!has_token()) return false;
+        if (*p_ == '+') ++p_;
+        std::from_chars_result r = std::from_chars(p_, end_, v);
+        if (r.ec != std::errc()) return false;
+        p_ = r.ptr;
+        return true;
+    }
+
+    // 匹配一个关键字（如"OFF"），关键字之后必须是分隔符
+    bool read_keyword(const char *kw) {
+        size_t n = std::strlen(kw);
+        if (static_cast<size_t>(end_ - p_) < n || std::memcmp(p_, kw, n) != 0) return false;
+        const char *q = p_ + n;
+        if (q < end_ && *q != ' ' && *q != '\t' && *q != '\r' && *q != '\n' && *q != '#') return false;
+        p_ = q;
+        return true;
+    }
+
+private:
+    void skip_inline_ws() {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\r' || *p_ == '\f' || *p_ == '\v')) ++p_;
+    }
+
+    const char *p_;
+    const char *end_;
+};
+
+
+// OFF文件读取器：先解析文件头得到点数和单元数，由调用者分配数组后再读入数据
+class OffReader {
+public:
+    explicit OffReader(const std::string &path) : path_(path), file_(path), scan_(file_.begin(), file_.end()),
+                                                  nVertex_(0), nElement_(0) {
+        scan_.next_record();
+        if (!scan_.read_keyword("OFF")) {
+            fail(scan_.pos(), "Not a valid OFF header");
+        }
+        // 计数可能与"OFF"在同一行，也可能在下一行
+        if (!scan_.has_token()) scan_.next_record();
+        if (!scan_.read_uint(nVertex_) || !scan_.read_uint(nElement_)) {
+            fail(scan_.pos(), "Invalid OFF size line");
+        }
+        scan_.skip_line();   // 忽略边数
+        // 编号用index_t存放，超出范围时在分配数组之前报错
+        check_index_range(nVertex_, "vertices");
+        check_index_range(nElement_, "elements");
+    }
+
+    unsigned long nVertex() const { return nVertex_; }
+    unsigned long nElement() const { return nElement_; }
+    size_t size() const { return file_.size(); }
+
+    // 读入点坐标和单元（每个单元必须恰好有nv个顶点）
+    // 数据区按行边界切分为若干块：先并行统计每块中的记录数，前缀和得到每块第一个记录的全局编号，
+    // 再并行地把各块直接解析到目标数组中，结果与串行读取完全一致
+    void read(double *x, double *y, double *z, index_t *const *elem, int nv, unsigned nthreads) {
+        const char *body = scan_.pos();
+        const char *end = file_.end();
+        size_t bytes = end - body;
+
+        unsigned long nchunk = 1;
+        if (nthreads > 1 && bytes > min_chunk_bytes) {
+            nchunk = 4ul * nthreads;
+            if (nchunk > bytes / min_chunk_bytes) nchunk = bytes / min_chunk_bytes;
+        }
+        // 块边界对齐到行首
+        std::vector<const char *> bound(nchunk + 1);
+        bound[0] = body;
+        bound[nchunk] = end;
+        for (unsigned long c = 1; c < nchunk; ++c) {
+            const char *p = body + bytes * c / nchunk;
+            if (p < bound[c - 1]) p = bound[c - 1];
+            const void *nl = std::memchr(p, '\n', end - p);
+            bound[c] = nl ? static_cast<const char *>(nl) + 1 : end;
+        }
+
+        // 每块第一个记录的编号；最后一块的记录数不需要统计
+        std::vector<unsigned long> first(nchunk + 1, 0);
+        parallel_for(0, nchunk - 1, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+            for (unsigned long c = lo; c < hi; ++c) first[c + 1] = count_records(bound[c], bound[c + 1]);
+        });
+        for (unsigned long c = 1; c < nchunk; ++c) first[c] += first[c - 1];
+
+        std::vector<unsigned long> last(nchunk, 0);
+        parallel_for(0, nchunk, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+            for (unsigned long c = lo; c < hi; ++c)
+                last[c] = parse_records(bound[c], bound[c + 1], first[c], x, y, z, elem, nv);
+        });
+        if (last[nchunk - 1] < nVertex_ + nElement_) {
+            fail(file_.end(), "Unexpected end of OFF file");
+        }
+    }
+
+    // 顺序读入全部记录而不分配整个网格：对每个点调用vertex(i, x, y, z)，
+    // 对每个单元调用element(i, v)，v为nv个顶点编号；已读过的文件页随时释放，常驻内存与文件大小无关
+    template <class VertexFn, class ElementFn>
+    void stream(int nv, VertexFn &&vertex, ElementFn &&element) {
+        OffScanner scan(scan_.pos(), file_.end());
+        const char *released = scan_.pos();
+        std::vector<unsigned long> v(nv);
+        const unsigned long nrecord = nVertex_ + nElement_;
+        unsigned long r = 0;
+        for (scan.next_record(); !scan.eof() && r < nrecord; scan.next_record(), ++r) {
+            if (r < nVertex_) {
+                double x, y, z;
+                if (!scan.read_double(x) || !scan.read_double(y) || !scan.read_double(z)) {
+                    fail(scan.pos(), error_message("Invalid vertex record ", r));
+                }
+                vertex(r, x, y, z);
+            } else {
+                unsigned long i = r - nVertex_, n;
+                if (!scan.read_uint(n) || n != static_cast<unsigned long>(nv)) {
+                    fail(scan.pos(), error_message("Element ", i, " does not have ", nv, " vertices"));
+                }
+                for (int j = 0; j < nv; ++j) {
+                    if (!scan.read_uint(v[j]) || v[j] >= nVertex_) {
+                        fail(scan.pos(), error_message("Invalid vertex index in element ", i));
+                    }
+                }
+                element(i, v.data());
+            }
+            scan.skip_line();
+            if (static_cast<size_t>(scan.pos() - released) >= discard_bytes) {
+                file_.discard(released, scan.pos());
+                released = scan.pos();
+            }
+        }
+        if (r < nrecord) {
+            fail(file_.end(), "Unexpected end of OFF file");
+        }
+    }
+
+private:
+    static const size_t min_chunk_bytes = 1 << 20;
+    static const size_t discard_bytes = 8 << 20;
+
+    // 报告pos所在行的错误；行号只在出错时由文件开头数换行符得到，读取时不做任何统计
+    [[noreturn]] void fail(const char *pos, const std::string &message) const {
+        unsigned long line = 1 + std::count(file_.begin(), pos, '\n');
+        if (pos == file_.end() && pos != file_.begin() && pos[-1] == '\n') --line;
+        throw ParseError(path_, line, message);
+    }
+
+    static unsigned long count_records(const char *begin, const char *end) {
+        OffScanner scan(begin, end);
+        unsigned long n = 0;
+        for (scan.next_record(); !scan.eof(); scan.next_record()) {
+            ++n;
+            scan.skip_line();
+        }
+        return n;
+    }
+
+    // 解析[begin, end)中的记录，第一个记录的全局编号为r；返回解析结束后的记录编号
+    // 编号小于nVertex_的记录是点，其后nElement_个记录是单元，多余的记录被忽略
+    unsigned long parse_records(const char *begin, const char *end, unsigned long r,
+                                double *x, double *y, double *z, index_t *const *elem, int nv) const {
+        OffScanner scan(begin, end);
+        const unsigned long nrecord = nVertex_ + nElement_;
+        for (scan.next_record(); !scan.eof() && r < nrecord; scan.next_record(), ++r) {
+            if (r < nVertex_) {
+                if (!scan.read_double(x[r]) || !scan.read_double(y[r]) || !scan.read_double(z[r])) {
+                    fail(scan.pos(), error_message("Invalid vertex record ", r));
+                }
+            } else {
+                unsigned long i = r - nVertex_, n;
+                if (!scan.read_uint(n) || n != static_cast<unsigned long>(nv)) {
+                    fail(scan.pos(), error_message("Element ", i, " does not have ", nv, " vertices"));
+                }
+                for (int j = 0; j < nv; ++j) {
+                    unsigned long v;
+                    if (!scan.read_uint(v) || v >= nVertex_) {
+                        fail(scan.pos(), error_message("Invalid vertex index in element ", i));
+                    }
+                    elem[j][i] = static_cast<index_t>(v);
+                }
+            }
+            scan.skip_line();
+        }
+        return r;
+    }
+
+    std::string path_;
+    MappedFile file_;
+    OffScanner scan_;
+    unsigned long nVertex_;
+    unsigned long nElement_;
+};
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_OFF_READER_H
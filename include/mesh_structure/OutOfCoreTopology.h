@@ -0,0 +1,191 @@
+#ifndef MESH_STRUCTURE_OUT_OF_CORE_TOPOLOGY_H
+#define MESH_STRUCTURE_OUT_OF_CORE_TOPOLOGY_H
+
+#include <string>
+
+#include "mesh_structure/ExternalSort.h"
+#include "mesh_structure/OffReader.h"
+#include "mesh_structure/Snapshot.h"
+#include "mesh_structure/TopologyBuilder.h"
+
+namespace mesh_structure {
+
+namespace detail {
+
+// 记录r = i*NS + j表示单元i的第j个子实体
+template <int SV>
+struct KeyRecord {
+    index_t key[SV];
+    unsigned long r;
+    bool operator<(const KeyRecord &o) const {
+        for (int a = 0; a < SV; ++a) {
+            if (key[a] != o.key[a]) return key[a] < o.key[a];
+        }
+        return r < o.r;
+    }
+};
+
+// 一个子实体：first/last为其第一个和最后一个记录，shared表示至少出现两次
+template <int SV>
+struct EntityRecord {
+    unsigned long first;
+    index_t key[SV];
+    unsigned long last;
+    unsigned long shared;
+    bool operator<(const EntityRecord &o) const { return first < o.first; }
+};
+
+// 记录r属于第一个记录为first的子实体
+struct MemberRecord {
+    unsigned long first;
+    unsigned long r;
+    bool operator<(const MemberRecord &o) const { return first != o.first ? first < o.first : r < o.r; }
+};
+
+struct ConnRecord {
+    unsigned long r;
+    unsigned long id;
+    bool operator<(const ConnRecord &o) const { return r < o.r; }
+};
+
+}  // namespace detail
+
+
+// 外存（流式）子实体提取：从OFF文件顺序读入网格，直接生成网格类的二进制快照（见Snapshot.h），
+// 快照中的数组与先read_off再collect_*后write_snapshot得到的完全相同，可用read_snapshot映射使用
+// 内存用量由memory_budget限定，与网格大小无关，超出部分以有序段的形式写入scratch_dir：
+//   1. 顺序读入OFF，坐标和单元直接写入快照，子实体键(排序后的顶点, r)进入外部排序
+//   2. 归并后相同的键连续出现，得到每个子实体的第一个/最后一个记录和出现次数
+//   3. 子实体按第一个记录排序即为内存中的编号顺序（第一次出现的顺序），依次写出子实体表、order和boundary
+//   4. 记录按所属子实体的第一个记录排序得到编号，再按r排序写出单元-子实体关系
+// 对合法网格（单元内没有重复顶点）结果与collect_topology一致
+template <int NV, int NS, int SV>
+void collect_topology_out_of_core(const std::string &off_path, const std::string &snapshot_path,
+                                  const int (&local)[NS][SV], uint32_t element_type, size_t memory_budget,
+                                  const std::string &scratch_dir) {
+    typedef detail::KeyRecord<SV> KeyRecord;
+    typedef detail::EntityRecord<SV> EntityRecord;
+    typedef detail::MemberRecord MemberRecord;
+    typedef detail::ConnRecord ConnRecord;
+
+    OffReader reader(off_path);
+    const unsigned long nVertex = reader.nVertex(), nElement = reader.nElement();
+    const size_t stream_buffer = 256 << 10;
+    // 任一时刻至多两个排序器在工作（一个归并、一个接收），各自的内存之和不超过预算
+    const size_t sort_memory = std::max<size_t>(memory_budget, 4 << 20) / 2;
+
+    // 数组顺序：坐标、单元、子实体表、conn、order、boundary
+    SnapshotStreamWriter writer(snapshot_path, 3 + NV + (SV + 2) + NS + 2 + 1);
+
+    // 1. 读入网格并生成子实体键
+    ExternalSorter<KeyRecord> keys(scratch_dir, sort_memory);
+    {
+        SnapshotArrayStream<double> coord[3];
+        SnapshotArrayStream<index_t> elem[NV];
+        for (int d = 0; d < 3; ++d) coord[d].open(writer, nVertex, stream_buffer);
+        for (int j = 0; j < NV; ++j) elem[j].open(writer, nElement, stream_buffer);
+        reader.stream(NV, [&](unsigned long, double x, double y, double z) {
+            coord[0].put(x);
+            coord[1].put(y);
+            coord[2].put(z);
+        }, [&](unsigned long i, const unsigned long *v) {
+            for (int j = 0; j < NV; ++j) elem[j].put(v[j]);
+            for (int j = 0; j < NS; ++j) {
+                KeyRecord rc;
+                for (int a = 0; a < SV; ++a) rc.key[a] = v[local[j][a]];
+                detail::sort_key<SV>(rc.key);
+                rc.r = i * NS + j;
+                keys.push(rc);
+            }
+        });
+        for (int d = 0; d < 3; ++d) coord[d].close();
+        for (int j = 0; j < NV; ++j) elem[j].close();
+    }
+
+    // 2. 归并相同的键
+    unsigned long nEntity = 0, nBoundary = 0;
+    ExternalSorter<EntityRecord> entities(scratch_dir, sort_memory / 2);
+    ExternalSorter<MemberRecord> members(scratch_dir, sort_memory / 2);
+    {
+        EntityRecord cur;
+        bool open = false;
+        auto close_entity = [&]() {
+            if (!open) return;
+            ++nEntity;
+            if (!cur.shared) ++nBoundary;
+            entities.push(cur);
+        };
+        keys.merge([&](const KeyRecord &rc) {
+            bool same = open;
+            for (int a = 0; same && a < SV; ++a) same = rc.key[a] == cur.key[a];
+            if (same) {
+                cur.last = rc.r;
+                cur.shared = 1;
+            } else {
+                close_entity();
+                cur.first = cur.last = rc.r;
+                for (int a = 0; a < SV; ++a) cur.key[a] = rc.key[a];
+                cur.shared = 0;
+                open = true;
+            }
+            MemberRecord m;
+            m.first = cur.first;
+            m.r = rc.r;
+            members.push(m);
+        });
+        close_entity();
+    }
+    check_index_range(nEntity, "sub-entities");
+
+    // 3. 按第一次出现的顺序写出子实体
+    SnapshotArrayStream<index_t> entity[SV + 2], conn[NS], boundary;
+    SnapshotArrayStream<local_t> order[2];
+    for (int a = 0; a < SV + 2; ++a) entity[a].open(writer, nEntity, stream_buffer);
+    for (int j = 0; j < NS; ++j) conn[j].open(writer, nElement, stream_buffer);
+    for (int a = 0; a < 2; ++a) order[a].open(writer, nEntity, stream_buffer);
+    boundary.open(writer, nBoundary, stream_buffer);
+    {
+        unsigned long id = 0;
+        entities.merge([&](const EntityRecord &e) {
+            for (int a = 0; a < SV; ++a) entity[a].put(e.key[a]);
+            entity[SV].put(e.first / NS);
+            entity[SV + 1].put(e.shared ? e.last / NS : nElement + 1);
+            order[0].put(e.first % NS);
+            order[1].put(e.shared ? e.last % NS : NS);
+            if (!e.shared) boundary.put(id);
+            ++id;
+        });
+    }
+    for (int a = 0; a < SV + 2; ++a) entity[a].close();
+    for (int a = 0; a < 2; ++a) order[a].close();
+    boundary.close();
+
+    // 4. 单元-子实体关系
+    {
+        ExternalSorter<ConnRecord> conns(scratch_dir, sort_memory);
+        unsigned long id = 0, prev = ~0ul;
+        members.merge([&](const MemberRecord &m) {
+            if (prev != ~0ul && m.first != prev) ++id;
+            prev = m.first;
+            ConnRecord c;
+            c.r = m.r;
+            c.id = id;
+            conns.push(c);
+        });
+        conns.merge([&](const ConnRecord &c) { conn[c.r % NS].put(c.id); });
+    }
+    for (int j = 0; j < NS; ++j) conn[j].close();
+
+    SnapshotHeader header;
+    header.index_bytes = sizeof(index_t);
+    header.element_type = element_type;
+    header.nVertex = nVertex;
+    header.nElement = nElement;
+    header.nSub = nEntity;
+    header.nBoundary = nBoundary;
+    writer.finish(header);
+}
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_OUT_OF_CORE_TOPOLOGY_H
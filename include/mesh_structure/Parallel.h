@@ -0,0 +1,82 @@
+#ifndef MESH_STRUCTURE_PARALLEL_H
+#define MESH_STRUCTURE_PARALLEL_H
+
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mesh_structure {
+
+// 线程数为0时使用全部硬件线程
+inline unsigned resolve_threads(unsigned nthreads) {
+    if (nthreads != 0) return nthreads;
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+// 在nthreads个线程上执行f(tid)，tid = 0..nthreads-1，当前线程承担tid = 0
+// 任意线程抛出的第一个异常会在所有线程结束后重新抛出
+template <class F>
+void parallel_run(unsigned nthreads, F &&f) {
+    if (nthreads <= 1) {
+        f(0u);
+        return;
+    }
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto guarded = [&](unsigned tid) {
+        try {
+            f(tid);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(nthreads - 1);
+    for (unsigned t = 1; t < nthreads; ++t) workers.emplace_back(guarded, t);
+    guarded(0u);
+    for (std::thread &w : workers) w.join();
+    if (error) std::rethrow_exception(error);
+}
+
+// 把[begin, end)均匀分成nthreads段，每段调用一次f(lo, hi, tid)
+template <class F>
+void parallel_for(unsigned long begin, unsigned long end, unsigned nthreads, F &&f) {
+    if (end <= begin) return;
+    unsigned long n = end - begin;
+    if (nthreads == 0) nthreads = 1;
+    if (nthreads > n) nthreads = static_cast<unsigned>(n);
+    parallel_run(nthreads, [&](unsigned tid) {
+        unsigned long lo = begin + n * tid / nthreads;
+        unsigned long hi = begin + n * (tid + 1) / nthreads;
+        f(lo, hi, tid);
+    });
+}
+
+// 并行的原地前缀和（不含自身），返回总和
+inline unsigned long parallel_exclusive_scan(unsigned long *a, unsigned long n, unsigned nthreads) {
+    if (nthreads == 0) nthreads = 1;
+    if (nthreads > n) nthreads = n == 0 ? 1 : static_cast<unsigned>(n);
+    std::vector<unsigned long> partial(nthreads + 1, 0);
+    parallel_for(0, n, nthreads, [&](unsigned long lo, unsigned long hi, unsigned tid) {
+        unsigned long sum = 0;
+        for (unsigned long i = lo; i < hi; ++i) sum += a[i];
+        partial[tid + 1] = sum;
+    });
+    for (unsigned t = 0; t < nthreads; ++t) partial[t + 1] += partial[t];
+    parallel_for(0, n, nthreads, [&](unsigned long lo, unsigned long hi, unsigned tid) {
+        unsigned long sum = partial[tid];
+        for (unsigned long i = lo; i < hi; ++i) {
+            unsigned long v = a[i];
+            a[i] = sum;
+            sum += v;
+        }
+    });
+    return partial[nthreads];
+}
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_PARALLEL_H
@@ -0,0 +1,160 @@
+#ifndef MESH_STRUCTURE_PARTITION_H
+#define MESH_STRUCTURE_PARTITION_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mesh_structure/Error.h"
+#include "mesh_structure/Index.h"
+#include "mesh_structure/Parallel.h"
+#include "mesh_structure/Snapshot.h"
+
+namespace mesh_structure {
+
+// 分区后一个部分的子网格与全局网格之间的编号映射（子网格本身见Mesh::extract_parts）
+// 子网格的前nOwned个单元属于本部分，其后是一层幽灵单元：不属于本部分、但与本部分的单元共享子实体的单元
+struct PartMap {
+    unsigned long part = 0;              // 本部分的编号
+    unsigned long nParts = 0;
+    unsigned long nOwned = 0;            // 本部分拥有的单元数
+    std::vector<index_t> vertex_global;  // 局部点 -> 全局点，按全局编号升序
+    std::vector<index_t> vertex_owner;   // 局部点所属的部分：包含该点的全局单元所属部分中编号最小的
+    std::vector<index_t> element_global; // 局部单元 -> 全局单元，自有单元和幽灵单元各自按全局编号升序
+    std::vector<index_t> ghost_owner;    // 幽灵单元所属的部分，第k个对应局部单元nOwned+k
+    std::vector<index_t> sub_global;     // 局部子实体 -> 全局子实体
+    std::vector<index_t> interface;      // 交界子实体（局部编号）：一侧为自有单元，另一侧为幽灵单元
+};
+
+// 分区映射文件沿用快照格式，文件头中的element_type为part_map_type
+const uint32_t part_map_type = 0x50415254;   // "PART"
+
+inline void write_part_map(const std::string &path, const PartMap &map) {
+    SnapshotHeader header;
+    header.index_bytes = sizeof(index_t);
+    header.element_type = part_map_type;
+    header.nVertex = map.vertex_global.size();
+    header.nElement = map.element_global.size();
+    header.nSub = map.sub_global.size();
+    header.nBoundary = map.interface.size();
+    const uint64_t info[3] = {map.part, map.nParts, map.nOwned};
+    const std::vector<index_t> *a[6] = {&map.vertex_global, &map.vertex_owner, &map.element_global,
+                                        &map.ghost_owner, &map.sub_global, &map.interface};
+    std::vector<SnapshotArray> arrays;
+    arrays.push_back({info, sizeof(info)});
+    for (int k = 0; k < 6; ++k) arrays.push_back({a[k]->data(), a[k]->size() * sizeof(index_t)});
+    write_snapshot_file(path, header, arrays);
+}
+
+inline void read_part_map(const std::string &path, PartMap &map) {
+    SnapshotMapping m;
+    const SnapshotHeader &h = m.open(path, part_map_type);
+    const uint64_t *info = m.array<uint64_t>(0, 3);
+    map.part = info[0];
+    map.nParts = info[1];
+    map.nOwned = info[2];
+    if (map.nOwned > h.nElement) {
+        throw FileError(path, "Not a valid partition map");
+    }
+    const uint64_t count[6] = {h.nVertex, h.nVertex, h.nElement, h.nElement - map.nOwned, h.nSub, h.nBoundary};
+    std::vector<index_t> *a[6] = {&map.vertex_global, &map.vertex_owner, &map.element_global,
+                                  &map.ghost_owner, &map.sub_global, &map.interface};
+    for (int k = 0; k < 6; ++k) {
+        const index_t *p = m.array<index_t>(k + 1, count[k]);
+        a[k]->assign(p, p + count[k]);
+    }
+}
+
+
+namespace detail {
+
+// 递归二分中待划分的一段：ids[begin, end)的单元分给first开始的count个部分
+struct RcbRange {
+    unsigned long begin, end;
+    unsigned long first, count;
+};
+
+}  // namespace detail
+
+// 递归坐标二分：每次沿单元形心包围盒的最长轴，在加权中位数处（按两侧的部分数分配单元数）切开，
+// 直到每段只对应一个部分。各部分的单元数之差不超过1，结果与线程数无关
+// 同一层的各段并行划分，第一层只有一段，因此前几层的并行度较低
+template <int NV>
+void partition_rcb(unsigned long nElement, const double *x, const double *y, const double *z,
+                   index_t *const *elem, unsigned long nParts, unsigned nthreads, index_t *part) {
+    const double *c[3] = {x, y, z};
+    std::vector<double> centroid[3];
+    for (int d = 0; d < 3; ++d) centroid[d].resize(nElement);
+    std::vector<index_t> ids(nElement);
+    parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        for (unsigned long i = lo; i < hi; ++i) {
+            for (int d = 0; d < 3; ++d) {
+                double s = 0;
+                for (int j = 0; j < NV; ++j) s += c[d][elem[j][i]];
+                centroid[d][i] = s / NV;
+            }
+            ids[i] = i;
+        }
+    });
+
+    std::vector<detail::RcbRange> level(1, detail::RcbRange{0, nElement, 0, nParts}), next, leaves;
+    while (!level.empty()) {
+        std::vector<detail::RcbRange> children(2 * level.size());
+        parallel_for(0, level.size(), nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+            for (unsigned long r = lo; r < hi; ++r) {
+                const detail::RcbRange &g = level[r];
+                double bmin[3] = {1e300, 1e300, 1e300}, bmax[3] = {-1e300, -1e300, -1e300};
+                for (unsigned long k = g.begin; k < g.end; ++k) {
+                    for (int d = 0; d < 3; ++d) {
+                        bmin[d] = std::min(bmin[d], centroid[d][ids[k]]);
+                        bmax[d] = std::max(bmax[d], centroid[d][ids[k]]);
+                    }
+                }
+                int axis = 0;
+                for (int d = 1; d < 3; ++d)
+                    if (bmax[d] - bmin[d] > bmax[axis] - bmin[axis]) axis = d;
+                const double *key = centroid[axis].data();
+
+                unsigned long n = g.end - g.begin, k1 = g.count / 2;
+                unsigned long mid = g.begin + n / g.count * k1 + n % g.count * k1 / g.count;
+                // 坐标相同时按编号比较，使结果确定
+                std::nth_element(ids.begin() + g.begin, ids.begin() + mid, ids.begin() + g.end,
+                                 [&](index_t a, index_t b) { return key[a] != key[b] ? key[a] < key[b] : a < b; });
+                children[2 * r] = detail::RcbRange{g.begin, mid, g.first, k1};
+                children[2 * r + 1] = detail::RcbRange{mid, g.end, g.first + k1, g.count - k1};
+            }
+        });
+        next.clear();
+        for (const detail::RcbRange &g : children) {
+            if (g.count > 1) next.push_back(g);
+            else leaves.push_back(g);
+        }
+        level.swap(next);
+    }
+
+    parallel_for(0, leaves.size(), nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        for (unsigned long r = lo; r < hi; ++r)
+            for (unsigned long k = leaves[r].begin; k < leaves[r].end; ++k) part[ids[k]] = leaves[r].first;
+    });
+}
+
+// 交界子实体数：两侧单元属于不同部分的子实体（即对偶图的割边数）
+inline unsigned long count_interface(unsigned long nSub, unsigned long nElement, const index_t *left,
+                                     const index_t *right, const index_t *part, unsigned nthreads) {
+    if (nthreads == 0) nthreads = 1;
+    std::vector<unsigned long> count(nthreads, 0);
+    parallel_for(0, nSub, nthreads, [&](unsigned long lo, unsigned long hi, unsigned tid) {
+        unsigned long n = 0;
+        for (unsigned long f = lo; f < hi; ++f)
+            if (right[f] < nElement && part[left[f]] != part[right[f]]) ++n;
+        count[tid] = n;
+    });
+    unsigned long n = 0;
+    for (unsigned long c : count) n += c;
+    return n;
+}
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_PARTITION_H
@@ -0,0 +1,37 @@
+#ifndef MESH_STRUCTURE_QUADRILATERAL_MESH_H
+#define MESH_STRUCTURE_QUADRILATERAL_MESH_H
+
+#include <string>
+#include <vector>
+
+#include "mesh_structure/Mesh.h"
+
+// 四边形网格，子实体为边；顶点按环绕顺序给出，OFF文件中每个面4个顶点
+// 实现在Mesh<QuadrilateralTraits>中（见Mesh.h），几何量用标量循环计算（按顶点0扇形剖分）
+class QuadrilateralMesh : public mesh_structure::Mesh<mesh_structure::QuadrilateralTraits> {
+public:
+    // 深拷贝，见Mesh::clone_from
+    QuadrilateralMesh clone() const { QuadrilateralMesh m; m.clone_from(*this); return m; }
+
+    unsigned long getNEdge()  {  return nSub;   }
+    unsigned long getNQuadrilateral() { return nElement; }
+
+    mesh_structure::index_t **quadrilateral()  { return elem_; }
+    mesh_structure::index_t **edge_info() { return sub_; }
+    mesh_structure::index_t **quad_edge_connection() {  return elem_sub_conn_; }
+    mesh_structure::local_t **edge_order_in_quad() { return sub_order_; }
+
+    void collect_edges(){ collect_sub_entities(); }
+
+    mesh_structure::CsrView vertex_quadrilateral() { return vertex_element(); }
+    mesh_structure::CsrView vertex_edge() { return vertex_sub(); }
+    mesh_structure::CsrView quadrilateral_quadrilateral() { return element_element(); }
+
+    double **quadrilateral_normal() { return elem_normal_; }
+    double *quadrilateral_area() { return elem_measure_; }
+    double **quadrilateral_centroid() { return elem_centroid_; }
+};    // QuadrilateralMesh
+
+extern template class mesh_structure::Mesh<mesh_structure::QuadrilateralTraits>;
+
+#endif // MESH_STRUCTURE_QUADRILATERAL_MESH_H
@@ -0,0 +1,192 @@
+#ifndef MESH_STRUCTURE_REFINE_H
+#define MESH_STRUCTURE_REFINE_H
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "mesh_structure/Arena.h"
+#include "mesh_structure/Csr.h"
+#include "mesh_structure/Index.h"
+#include "mesh_structure/Parallel.h"
+
+namespace mesh_structure {
+
+// 单纯形的局部边：第k条边由哪两个局部顶点组成（三角形与TriangleTraits的边相同）
+template <int NV>
+struct SimplexEdges;
+
+template <>
+struct SimplexEdges<3> {
+    static constexpr int ne = 3;
+    static constexpr int local[3][2] = {{0, 1}, {1, 2}, {2, 0}};
+};
+
+template <>
+struct SimplexEdges<4> {
+    static constexpr int ne = 6;
+    static constexpr int local[6][2] = {{0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}};
+};
+
+// 提取单元的边，返回边数。edge[0]<edge[1]为两个端点，边按(edge[0], edge[1])升序编号；
+// elem_edge[k][i]为单元i的第k条局部边。数组都从arena分配
+// 先按较小的端点把每条局部边放入CSR的行中（行内排序），再逐行去重并前缀求和得到编号，全程不需要加锁
+template <int NV, int NE>
+unsigned long collect_edges(unsigned long nVertex, unsigned long nElement, index_t *const *elem,
+                            const int (*local)[2], unsigned nthreads, index_t **edge, index_t **elem_edge,
+                            ArrayArena &arena) {
+    unsigned long *offset;
+    index_t *other;
+    build_csr(nVertex, nElement, nthreads, [&](unsigned long i, auto &&sink) {
+        for (int k = 0; k < NE; ++k) {
+            index_t a = elem[local[k][0]][i], b = elem[local[k][1]][i];
+            if (a < b) sink(a, b);
+            else sink(b, a);
+        }
+    }, offset, other, arena);
+
+    // first[v]: 以v为较小端点的第一条边的编号；行内去重后的元素留在该行的开头
+    unsigned long *first = arena.allocate<unsigned long>(nVertex + 1);
+    parallel_for(0, nVertex, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        for (unsigned long v = lo; v < hi; ++v)
+            first[v] = std::unique(other + offset[v], other + offset[v + 1]) - (other + offset[v]);
+    });
+    first[nVertex] = 0;
+    unsigned long nEdge = parallel_exclusive_scan(first, nVertex + 1, nthreads);
+    check_index_range(nEdge, "edges");
+
+    edge[0] = arena.allocate<index_t>(nEdge);
+    edge[1] = arena.allocate<index_t>(nEdge);
+    parallel_for(0, nVertex, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        for (unsigned long v = lo; v < hi; ++v) {
+            for (unsigned long k = 0; k < first[v + 1] - first[v]; ++k) {
+                edge[0][first[v] + k] = v;
+                edge[1][first[v] + k] = other[offset[v] + k];
+            }
+        }
+    });
+    for (int k = 0; k < NE; ++k) elem_edge[k] = arena.allocate<index_t>(nElement);
+    parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        for (unsigned long i = lo; i < hi; ++i) {
+            for (int k = 0; k < NE; ++k) {
+                index_t a = elem[local[k][0]][i], b = elem[local[k][1]][i];
+                if (b < a) std::swap(a, b);
+                const index_t *row = other + offset[a];
+                elem_edge[k][i] = first[a] + (std::lower_bound(row, row + (first[a + 1] - first[a]), b) - row);
+            }
+        }
+    });
+    arena.release(offset);
+    arena.release(other);
+    arena.release(first);
+    return nEdge;
+}
+
+
+namespace detail {
+
+// 单纯形一致加密（三角形1分4，四面体1分8）的局部模板
+// 局部点0..NV-1为父单元的顶点，NV+k为第k条局部边的中点；子单元的朝向与父单元相同
+// 子单元c的第j个子实体：on[c][j]>=0时位于父单元的第on[c][j]个子实体上，corner[c][j]为其中父单元顶点的局部编号
+// （面中间的那个子面为-1）；on[c][j]<0时为父单元内部的第inner[c][j]个新子实体，side[c][j]为它在该子实体中是第几侧
+template <class Traits>
+struct RefineTemplate {
+    static constexpr int NV = Traits::nv, NS = Traits::ns, SV = Traits::sv;
+    static constexpr int nChild = NV == 3 ? 4 : 8;
+    static constexpr int nInner = NV == 3 ? 3 : 8;
+    static constexpr int nSubChild = NV == 3 ? 2 : 4;   // 每个父子实体分成的子实体数
+
+    int child[nChild][NV];
+    int on[nChild][NS], corner[nChild][NS], inner[nChild][NS], side[nChild][NS];
+
+    // 四面体内部的八面体沿中点NV+diag[d][0]与NV+diag[d][1]之间的对角线剖分（三角形忽略d）
+    explicit RefineTemplate(int d) {
+        const int (*edges)[2] = SimplexEdges<NV>::local;
+        auto mid = [&](int a, int b) {
+            for (int k = 0; k < SimplexEdges<NV>::ne; ++k)
+                if ((edges[k][0] == a && edges[k][1] == b) || (edges[k][0] == b && edges[k][1] == a)) return NV + k;
+            return -1;
+        };
+        // 角上的子单元是父单元以该顶点为中心缩小一半，朝向不变
+        for (int v = 0; v < NV; ++v)
+            for (int u = 0; u < NV; ++u) child[v][u] = u == v ? v : mid(v, u);
+        if constexpr (NV == 3) {
+            child[3][0] = mid(1, 2);
+            child[3][1] = mid(2, 0);
+            child[3][2] = mid(0, 1);
+        } else {
+            // 其余四个中点绕对角线成环，相邻的两个所在的边有公共顶点
+            const int opposite[3][2] = {{0, 5}, {1, 4}, {2, 3}};
+            int p = NV + opposite[d][0], q = NV + opposite[d][1];
+            int ring[4], n = 0;
+            for (int k = 0; k < 6; ++k)
+                if (NV + k != p && NV + k != q) ring[n++] = NV + k;
+            auto share = [&](int m1, int m2) {
+                const int *e1 = edges[m1 - NV], *e2 = edges[m2 - NV];
+                return e1[0] == e2[0] || e1[0] == e2[1] || e1[1] == e2[0] || e1[1] == e2[1];
+            };
+            if (!share(ring[0], ring[1])) std::swap(ring[1], ring[2]);
+            if (!share(ring[1], ring[2])) std::swap(ring[2], ring[3]);
+            for (int k = 0; k < 4; ++k) {
+                int *t = child[4 + k];
+                t[0] = p; t[1] = q; t[2] = ring[k]; t[3] = ring[(k + 1) % 4];
+            }
+        }
+        // 在参考单元上检查朝向，与父单元相反时交换前两个顶点
+        double ref[NV + SimplexEdges<NV>::ne][3] = {};
+        for (int v = 1; v < NV; ++v) ref[v][v - 1] = 1;
+        for (int k = 0; k < SimplexEdges<NV>::ne; ++k)
+            for (int a = 0; a < 3; ++a) ref[NV + k][a] = 0.5 * (ref[edges[k][0]][a] + ref[edges[k][1]][a]);
+        for (int c = 0; c < nChild; ++c) {
+            const double *o = ref[child[c][0]];
+            double u[3], v[3], w[3] = {0, 0, 1};
+            for (int a = 0; a < 3; ++a) {
+                u[a] = ref[child[c][1]][a] - o[a];
+                v[a] = ref[child[c][2]][a] - o[a];
+                if (NV == 4) w[a] = ref[child[c][NV - 1]][a] - o[a];
+            }
+            double det = w[0] * (u[1] * v[2] - u[2] * v[1]) + w[1] * (u[2] * v[0] - u[0] * v[2]) +
+                         w[2] * (u[0] * v[1] - u[1] * v[0]);
+            if (det < 0) std::swap(child[c][0], child[c][1]);
+        }
+
+        // 子实体分类：全部顶点都在父单元某个子实体的闭包（顶点及其边的中点）内的，位于该子实体上
+        std::vector<std::array<int, SV>> inner_key;
+        for (int c = 0; c < nChild; ++c) {
+            for (int j = 0; j < NS; ++j) {
+                std::array<int, SV> key;
+                for (int a = 0; a < SV; ++a) key[a] = child[c][Traits::local[j][a]];
+                std::sort(key.begin(), key.end());
+                on[c][j] = -1;
+                corner[c][j] = -1;
+                for (int jp = 0; jp < NS && on[c][j] < 0; ++jp) {
+                    bool inside = true;
+                    for (int a = 0; a < SV && inside; ++a) {
+                        bool found = false;
+                        for (int x = 0; x < SV; ++x) {
+                            int px = Traits::local[jp][x];
+                            found = found || key[a] == px;
+                            for (int y = x + 1; y < SV; ++y) found = found || key[a] == mid(px, Traits::local[jp][y]);
+                        }
+                        inside = found;
+                    }
+                    if (inside) on[c][j] = jp;
+                }
+                if (on[c][j] >= 0) {
+                    if (key[0] < NV) corner[c][j] = key[0];
+                    continue;
+                }
+                auto it = std::find(inner_key.begin(), inner_key.end(), key);
+                side[c][j] = it != inner_key.end();
+                inner[c][j] = it - inner_key.begin();
+                if (it == inner_key.end()) inner_key.push_back(key);
+            }
+        }
+    }
+};
+
+}  // namespace detail
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_REFINE_H
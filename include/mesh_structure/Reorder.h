@@ -0,0 +1,252 @@
+#ifndef MESH_STRUCTURE_REORDER_H
+#define MESH_STRUCTURE_REORDER_H
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "mesh_structure/Csr.h"
+#include "mesh_structure/Parallel.h"
+#include "mesh_structure/TopologyBuilder.h"
+
+namespace mesh_structure {
+
+// 重排方法
+// Morton: 单元按形心的Morton(Z曲线)码排序，点按在新单元顺序中第一次出现的次序编号
+// RCM:    点按Reverse Cuthill-McKee排序以减小带宽，单元按其最小的新点编号稳定排序
+enum class ReorderMethod { Morton, RCM };
+
+namespace detail {
+
+// 把21位整数的各位间隔两位展开
+inline unsigned long spread_bits(unsigned long v) {
+    v &= 0x1ffffful;
+    v = (v | v << 32) & 0x1f00000000fffful;
+    v = (v | v << 16) & 0x1f0000ff0000fful;
+    v = (v | v << 8) & 0x100f00f00f00f00ful;
+    v = (v | v << 4) & 0x10c30c30c30c30c3ul;
+    v = (v | v << 2) & 0x1249249249249249ul;
+    return v;
+}
+
+template <int NV>
+void morton_order(unsigned long nVertex, unsigned long nElement, const double *x, const double *y, const double *z,
+                  index_t *const *elem, unsigned nthreads, unsigned long *vperm, unsigned long *eperm) {
+    double lo[3] = {1e300, 1e300, 1e300}, hi[3] = {-1e300, -1e300, -1e300};
+    const double *c[3] = {x, y, z};
+    for (int d = 0; d < 3; ++d) {
+        for (unsigned long i = 0; i < nVertex; ++i) {
+            lo[d] = std::min(lo[d], c[d][i]);
+            hi[d] = std::max(hi[d], c[d][i]);
+        }
+    }
+    double scale[3];
+    for (int d = 0; d < 3; ++d) scale[d] = hi[d] > lo[d] ? 2097151.0 / (hi[d] - lo[d]) : 0.0;
+
+    std::vector<std::pair<unsigned long, unsigned long>> code(nElement);
+    parallel_for(0, nElement, nthreads, [&](unsigned long b, unsigned long e, unsigned) {
+        for (unsigned long i = b; i < e; ++i) {
+            unsigned long key = 0;
+            for (int d = 0; d < 3; ++d) {
+                double s = 0;
+                for (int j = 0; j < NV; ++j) s += c[d][elem[j][i]];
+                key |= spread_bits(static_cast<unsigned long>((s / NV - lo[d]) * scale[d])) << d;
+            }
+            code[i] = std::make_pair(key, i);
+        }
+    });
+    std::sort(code.begin(), code.end());
+
+    // 点按第一次被访问的顺序编号，孤立点排在最后
+    const unsigned long UNSET = ~0ul;
+    std::vector<unsigned long> vinv(nVertex, UNSET);
+    unsigned long nv = 0;
+    for (unsigned long k = 0; k < nElement; ++k) {
+        unsigned long i = code[k].second;
+        eperm[k] = i;
+        for (int j = 0; j < NV; ++j) {
+            unsigned long v = elem[j][i];
+            if (vinv[v] == UNSET) {
+                vinv[v] = nv;
+                vperm[nv++] = v;
+            }
+        }
+    }
+    for (unsigned long v = 0; v < nVertex; ++v) {
+        if (vinv[v] == UNSET) vperm[nv++] = v;
+    }
+}
+
+template <int NV>
+void rcm_order(unsigned long nVertex, unsigned long nElement, index_t *const *elem, unsigned nthreads,
+               unsigned long *vperm, unsigned long *eperm) {
+    // 点-点邻接（经由共同单元），每行排序去重；放在临时的arena中，函数返回时释放
+    ArrayArena scratch;
+    unsigned long *vv_offset;
+    index_t *vv;
+    build_csr(nVertex, nElement, nthreads, [&](unsigned long i, auto &&sink) {
+        for (int a = 0; a < NV; ++a)
+            for (int b = 0; b < NV; ++b)
+                if (a != b) sink(elem[a][i], elem[b][i]);
+    }, vv_offset, vv, scratch);
+    std::vector<unsigned long> degree(nVertex);
+    std::vector<unsigned long> vend(nVertex);
+    parallel_for(0, nVertex, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        for (unsigned long v = lo; v < hi; ++v) {
+            index_t *e = std::unique(vv + vv_offset[v], vv + vv_offset[v + 1]);
+            vend[v] = e - vv;
+            degree[v] = vend[v] - vv_offset[v];
+        }
+    });
+
+    const unsigned long UNSET = ~0ul;
+    std::vector<unsigned long> level(nVertex, UNSET), order;
+    order.reserve(nVertex);
+
+    // 从start做BFS，返回最后一层中度最小的点
+    auto bfs = [&](unsigned long start, std::vector<unsigned long> &out) {
+        out.clear();
+        out.push_back(start);
+        level[start] = 0;
+        unsigned long last = start;
+        for (unsigned long h = 0; h < out.size(); ++h) {
+            unsigned long v = out[h];
+            unsigned long first = out.size();
+            for (unsigned long p = vv_offset[v]; p < vend[v]; ++p) {
+                unsigned long w = vv[p];
+                if (level[w] == UNSET) {
+                    level[w] = level[v] + 1;
+                    out.push_back(w);
+                }
+            }
+            std::sort(out.begin() + first, out.end(), [&](unsigned long a, unsigned long b) {
+                return degree[a] != degree[b] ? degree[a] < degree[b] : a < b;
+            });
+            if (level[v] > level[last] || (level[v] == level[last] && degree[v] < degree[last])) last = v;
+        }
+        return last;
+    };
+
+    std::vector<unsigned long> comp;
+    std::vector<unsigned long> seeds(nVertex);
+    for (unsigned long v = 0; v < nVertex; ++v) seeds[v] = v;
+    std::sort(seeds.begin(), seeds.end(), [&](unsigned long a, unsigned long b) {
+        return degree[a] != degree[b] ? degree[a] < degree[b] : a < b;
+    });
+    std::vector<char> done(nVertex, 0);
+    for (unsigned long s : seeds) {
+        if (done[s]) continue;
+        // 两次BFS近似伪外围点
+        unsigned long start = bfs(s, comp);
+        for (unsigned long v : comp) level[v] = UNSET;
+        bfs(start, comp);
+        for (unsigned long v : comp) done[v] = 1;
+        order.insert(order.end(), comp.begin(), comp.end());
+    }
+    for (unsigned long k = 0; k < nVertex; ++k) vperm[k] = order[nVertex - 1 - k];
+
+    std::vector<unsigned long> vinv(nVertex);
+    for (unsigned long k = 0; k < nVertex; ++k) vinv[vperm[k]] = k;
+    std::vector<std::pair<unsigned long, unsigned long>> key(nElement);
+    for (unsigned long i = 0; i < nElement; ++i) {
+        unsigned long m = vinv[elem[0][i]];
+        for (int j = 1; j < NV; ++j) m = std::min(m, vinv[elem[j][i]]);
+        key[i] = std::make_pair(m, i);
+    }
+    std::sort(key.begin(), key.end());
+    for (unsigned long k = 0; k < nElement; ++k) eperm[k] = key[k].second;
+
+}
+
+}  // namespace detail
+
+
+// 计算点和单元的新顺序，perm[新编号] = 旧编号
+template <int NV>
+void compute_ordering(ReorderMethod method, unsigned long nVertex, unsigned long nElement,
+                      const double *x, const double *y, const double *z, index_t *const *elem,
+                      unsigned nthreads, unsigned long *vperm, unsigned long *eperm) {
+    if (method == ReorderMethod::Morton) {
+        detail::morton_order<NV>(nVertex, nElement, x, y, z, elem, nthreads, vperm, eperm);
+    } else {
+        detail::rcm_order<NV>(nVertex, nElement, elem, nthreads, vperm, eperm);
+    }
+}
+
+// 按perm重排数组，返回从arena分配的新数组：b[k] = a[perm[k]]，原数组由调用者释放
+template <class T>
+T *permuted_array(const T *a, unsigned long n, const unsigned long *perm, unsigned nthreads, ArrayArena &arena) {
+    T *b = arena.allocate<T>(n);
+    parallel_for(0, n, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        for (unsigned long k = lo; k < hi; ++k) b[k] = a[perm[k]];
+    });
+    return b;
+}
+
+// 重排单元并替换其中的顶点编号，单元内的局部顺序（即朝向）保持不变，原数组由调用者释放
+template <int NV>
+void permuted_elements(index_t *const *elem, unsigned long nElement, const unsigned long *eperm,
+                       const unsigned long *vinv, unsigned nthreads, index_t **out, ArrayArena &arena) {
+    for (int j = 0; j < NV; ++j) {
+        index_t *b = arena.allocate<index_t>(nElement);
+        parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+            for (unsigned long k = lo; k < hi; ++k) b[k] = vinv[elem[j][eperm[k]]];
+        });
+        out[j] = b;
+    }
+}
+
+// 在点和单元重排之后更新子实体表
+// 子实体按在新单元顺序中第一次出现的次序重新编号，结果与对重排后的网格重新调用collect_*完全相同，
+// 但不需要哈希或排序。sub_perm（可为nullptr）返回子实体的 新编号 -> 旧编号
+template <int NS, int SV>
+void permute_topology(unsigned long nElement, unsigned long nEntity, const unsigned long *eperm,
+                      const unsigned long *vinv, index_t *const *entity, index_t *const *conn,
+                      unsigned nthreads, TopologyResult<NS, SV> &out, unsigned long *sub_perm,
+                      ArrayArena &arena) {
+    const unsigned long UNSET = ~0ul;
+    std::vector<unsigned long> inv(nEntity, UNSET), perm(nEntity);
+    std::vector<unsigned long> first(nEntity), last(nEntity);
+    std::vector<unsigned char> seen(nEntity, 0);
+    unsigned long n = 0;
+    for (int j = 0; j < NS; ++j) out.conn[j] = arena.allocate<index_t>(nElement);
+    for (unsigned long k = 0; k < nElement; ++k) {
+        unsigned long i = eperm[k];
+        for (int j = 0; j < NS; ++j) {
+            unsigned long e = conn[j][i];
+            if (inv[e] == UNSET) {
+                inv[e] = n;
+                first[n] = k;
+                perm[n++] = e;
+            }
+            last[e] = k;
+            if (seen[e] < 2) ++seen[e];
+            out.conn[j][k] = inv[e];
+        }
+    }
+
+    out.nEntity = n;
+    for (int a = 0; a < SV + 2; ++a) out.entity[a] = arena.allocate<index_t>(n);
+    parallel_for(0, n, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        for (unsigned long f = lo; f < hi; ++f) {
+            unsigned long e = perm[f];
+            index_t key[SV];
+            for (int a = 0; a < SV; ++a) key[a] = vinv[entity[a][e]];
+            detail::sort_key<SV>(key);
+            for (int a = 0; a < SV; ++a) out.entity[a][f] = key[a];
+        }
+    });
+    parallel_for(0, n, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        for (unsigned long f = lo; f < hi; ++f) {
+            unsigned long e = perm[f];
+            out.entity[SV][f] = first[f];
+            out.entity[SV + 1][f] = seen[e] >= 2 ? last[e] : nElement + 1;
+        }
+    });
+    detail::finish_topology<NS, SV>(nElement, nthreads, out, arena);
+    if (sub_perm != nullptr) std::copy(perm.begin(), perm.end(), sub_perm);
+}
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_REORDER_H
@@ -0,0 +1,281 @@
+#ifndef MESH_STRUCTURE_SNAPSHOT_H
+#define MESH_STRUCTURE_SNAPSHOT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mesh_structure/Error.h"
+#include "mesh_structure/Index.h"
+
+namespace mesh_structure {
+
+// 二进制网格快照格式（小端，版本2）
+//   SnapshotHeader
+//   nArray 个 {uint64 offset, uint64 bytes}，offset从文件开头算起
+//   各数组数据，起始位置按snapshot_alignment对齐
+// 数组的顺序由网格类约定：坐标、单元、子实体表、conn、order、boundary
+// 连接关系数组的元素为index_bytes字节的编号，order为1字节（版本1中为8字节）
+// 读取时直接映射文件，数组指针指向映射区，不做任何解析或重新计算
+struct SnapshotHeader {
+    char magic[8];           // "MESHSNAP"
+    uint32_t version;
+    uint32_t endian;         // 0x01020304，用于识别字节序
+    uint32_t index_bytes;    // 编号类型index_t的字节数，必须与读取方的构建选项一致
+    uint32_t element_type;   // 单元类型，见ElementTraits.h中的snapshot_type
+    uint64_t nVertex;
+    uint64_t nElement;
+    uint64_t nSub;           // 子实体数，0表示未提取
+    uint64_t nBoundary;
+    uint64_t nArray;
+};
+
+const uint32_t snapshot_version = 2;
+const uint64_t snapshot_alignment = 64;
+
+struct SnapshotArray {
+    const void *data;
+    uint64_t bytes;
+};
+
+// 流式写出快照：begin_array按顺序为各数组预留对齐的区域，之后各数组可以交错写入，
+// 文件头和数组表在finish时写入。数组的大小必须在begin_array时已知
+// 先写入同一目录下的临时文件(path.tmp.<pid>)，finish时fsync后rename替换path：原文件可能正被映射
+// （包括本进程中由read_snapshot读入、正要写回同一路径的网格），不能就地截断；出错时删除临时文件，原文件不变
+class SnapshotStreamWriter {
+public:
+    SnapshotStreamWriter(const std::string &path, uint64_t nArray)
+        : path_(path), tmp_(path + ".tmp." + std::to_string(::getpid())),
+          table_(), nArray_(nArray), end_(sizeof(SnapshotHeader) + 2 * nArray * sizeof(uint64_t)) {
+        fd_ = ::open(tmp_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0) {
+            throw FileError(path, "Cannot open snapshot file for writing");
+        }
+    }
+
+    // 没有finish（写入出错或提前退出）时删除临时文件
+    ~SnapshotStreamWriter() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            ::unlink(tmp_.c_str());
+        }
+    }
+
+    SnapshotStreamWriter(const SnapshotStreamWriter &) = delete;
+    SnapshotStreamWriter &operator=(const SnapshotStreamWriter &) = delete;
+
+    // 为下一个数组预留bytes字节，返回其在文件中的偏移
+    uint64_t begin_array(uint64_t bytes) {
+        if (table_.size() == 2 * nArray_) {
+            throw FileError(path_, "Too many arrays for snapshot file");
+        }
+        uint64_t off = (end_ + snapshot_alignment - 1) / snapshot_alignment * snapshot_alignment;
+        table_.push_back(off);
+        table_.push_back(bytes);
+        end_ = off + bytes;
+        return off;
+    }
+
+    void write(uint64_t offset, const void *data, uint64_t bytes) {
+        const char *p = static_cast<const char *>(data);
+        while (bytes > 0) {
+            ssize_t n = ::pwrite(fd_, p, bytes, static_cast<off_t>(offset));
+            if (n <= 0) fail();
+            p += n;
+            offset += n;
+            bytes -= n;
+        }
+    }
+
+    // 写入文件头和数组表，把文件补齐到最后一个数组的末尾，再替换path
+    void finish(SnapshotHeader header) {
+        if (table_.size() != 2 * nArray_) {
+            throw FileError(path_, "Missing arrays in snapshot file");
+        }
+        std::memcpy(header.magic, "MESHSNAP", 8);
+        header.version = snapshot_version;
+        header.endian = 0x01020304;
+        header.nArray = nArray_;
+        write(0, &header, sizeof(header));
+        write(sizeof(header), table_.data(), table_.size() * sizeof(uint64_t));
+        if (::ftruncate(fd_, static_cast<off_t>(end_)) != 0 || ::fsync(fd_) != 0) fail();
+        int fd = fd_;
+        fd_ = -1;
+        if (::close(fd) != 0 || ::rename(tmp_.c_str(), path_.c_str()) != 0) {
+            ::unlink(tmp_.c_str());
+            fail();
+        }
+    }
+
+private:
+    void fail() {
+        throw FileError(path_, "Failed to write snapshot file");
+    }
+
+    int fd_;
+    std::string path_, tmp_;
+    std::vector<uint64_t> table_;
+    uint64_t nArray_;
+    uint64_t end_;
+};
+
+
+// 快照中一个数组的顺序写入流，带缓冲
+template <class T>
+class SnapshotArrayStream {
+public:
+    SnapshotArrayStream() : writer_(nullptr), offset_(0), count_(0), written_(0) {}
+
+    void open(SnapshotStreamWriter &writer, uint64_t count, size_t buffer_bytes = 1 << 20) {
+        writer_ = &writer;
+        offset_ = writer.begin_array(count * sizeof(T));
+        count_ = count;
+        written_ = 0;
+        buf_.clear();
+        buf_.reserve(std::max<size_t>(buffer_bytes / sizeof(T), 1));
+    }
+
+    void put(const T &v) {
+        buf_.push_back(v);
+        if (buf_.size() == buf_.capacity()) flush();
+    }
+
+    // 写出剩余数据并检查元素个数
+    void close() {
+        flush();
+        std::vector<T>().swap(buf_);
+        if (written_ != count_) {
+            throw MeshError(error_message("Snapshot array has ", written_, " elements, expected ", count_, "!"));
+        }
+    }
+
+private:
+    void flush() {
+        if (buf_.empty()) return;
+        writer_->write(offset_ + written_ * sizeof(T), buf_.data(), buf_.size() * sizeof(T));
+        written_ += buf_.size();
+        buf_.clear();
+    }
+
+    SnapshotStreamWriter *writer_;
+    uint64_t offset_;
+    uint64_t count_;
+    uint64_t written_;
+    std::vector<T> buf_;
+};
+
+
+inline void write_snapshot_file(const std::string &path, const SnapshotHeader &header,
+                                const std::vector<SnapshotArray> &arrays) {
+    SnapshotStreamWriter writer(path, arrays.size());
+    for (const SnapshotArray &a : arrays) {
+        uint64_t off = writer.begin_array(a.bytes);
+        writer.write(off, a.data, a.bytes);
+    }
+    writer.finish(header);
+}
+
+
+// 快照文件的私有映射（写时复制）：未修改的页在多个进程之间共享页缓存，
+// 对数组的修改只影响本进程，不会写回文件
+class SnapshotMapping {
+public:
+    SnapshotMapping() : base_(nullptr), size_(0) {}
+    ~SnapshotMapping() { close(); }
+
+    SnapshotMapping(const SnapshotMapping &) = delete;
+    SnapshotMapping &operator=(const SnapshotMapping &) = delete;
+
+    SnapshotMapping(SnapshotMapping &&o) noexcept : base_(o.base_), size_(o.size_) {
+        o.base_ = nullptr;
+        o.size_ = 0;
+    }
+
+    SnapshotMapping &operator=(SnapshotMapping &&o) noexcept {
+        if (this != &o) {
+            close();
+            std::swap(base_, o.base_);
+            std::swap(size_, o.size_);
+        }
+        return *this;
+    }
+
+    // 映射文件并校验文件头，返回文件头
+    const SnapshotHeader &open(const std::string &path, uint32_t element_type) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw FileError(path, "Wrong file name or path");
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SnapshotHeader)) {
+            ::close(fd);
+            throw FileError(path, "Not a valid mesh snapshot");
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        void *p = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            size_ = 0;
+            throw FileError(path, "Cannot map snapshot file");
+        }
+        base_ = static_cast<char *>(p);
+
+        const SnapshotHeader &h = header();
+        bool ok = std::memcmp(h.magic, "MESHSNAP", 8) == 0 && h.version == snapshot_version &&
+                  h.endian == 0x01020304 && h.index_bytes == sizeof(index_t) &&
+                  h.element_type == element_type &&
+                  sizeof(SnapshotHeader) + 2 * h.nArray * sizeof(uint64_t) <= size_;
+        for (uint64_t a = 0; ok && a < h.nArray; ++a) {
+            uint64_t off = table()[2 * a], bytes = table()[2 * a + 1];
+            ok = off % snapshot_alignment == 0 && off <= size_ && bytes <= size_ - off;
+        }
+        if (!ok) {
+            close();
+            throw FileError(path, "Not a valid mesh snapshot");
+        }
+        return header();
+    }
+
+    void close() {
+        if (base_ != nullptr) ::munmap(base_, size_);
+        base_ = nullptr;
+        size_ = 0;
+    }
+
+    const SnapshotHeader &header() const { return *reinterpret_cast<const SnapshotHeader *>(base_); }
+
+    // 第a个数组，字节数必须为bytes
+    template <class T>
+    T *array(uint64_t a, uint64_t count) const {
+        if (a >= header().nArray || table()[2 * a + 1] != count * sizeof(T)) {
+            throw MeshError(error_message("Mesh snapshot array ", a, " has unexpected size!"));
+        }
+        return reinterpret_cast<T *>(base_ + table()[2 * a]);
+    }
+
+    // 指针是否位于映射区内（这样的数组随映射一起释放）
+    bool contains(const void *p) const {
+        const char *c = static_cast<const char *>(p);
+        return base_ != nullptr && c >= base_ && c <= base_ + size_;
+    }
+
+private:
+    const uint64_t *table() const { return reinterpret_cast<const uint64_t *>(base_ + sizeof(SnapshotHeader)); }
+
+    char *base_;
+    size_t size_;
+};
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_SNAPSHOT_H
@@ -0,0 +1,168 @@
+#ifndef MESH_STRUCTURE_SPARSITY_H
+#define MESH_STRUCTURE_SPARSITY_H
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "mesh_structure/Arena.h"
+#include "mesh_structure/Csr.h"
+#include "mesh_structure/Index.h"
+#include "mesh_structure/Parallel.h"
+
+namespace mesh_structure {
+
+// 散布表中不存在的位置（边界子实体的另一侧）
+constexpr unsigned long pattern_none = std::numeric_limits<unsigned long>::max();
+
+// 稀疏矩阵的非零结构（CSR）：第i行的列号为column[offset[i] .. offset[i+1])，行内升序且包含对角元
+// 另有散布表slot，把单元（或子实体）的局部位置直接映射到非零元的下标k，组装时 values[k] += a，不需要查找：
+//   点-点结构：slot[i*NV*NV + a*NV + b]为单元i的局部点a、b所在的行、列
+//   单元-单元结构：slot[4*s + 0..3]为子实体s的(左,左)、(左,右)、(右,左)、(右,右)，边界子实体只有第0个，其余为pattern_none
+// 数组在结构自己的存储区中，由Mesh::vertex_pattern和Mesh::element_pattern生成，重新生成时复用
+class SparsityPattern {
+public:
+    SparsityPattern() : nRow_(0), nSlot_(0), offset_(nullptr), column_(nullptr), slot_(nullptr) {}
+
+    SparsityPattern(const SparsityPattern &) = delete;
+    SparsityPattern &operator=(const SparsityPattern &) = delete;
+    SparsityPattern(SparsityPattern &&o) noexcept : SparsityPattern() { swap(o); }
+    SparsityPattern &operator=(SparsityPattern &&o) noexcept {
+        if (this != &o) {
+            SparsityPattern tmp(std::move(o));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    void swap(SparsityPattern &o) noexcept {
+        std::swap(arena_, o.arena_);
+        std::swap(nRow_, o.nRow_);
+        std::swap(nSlot_, o.nSlot_);
+        std::swap(offset_, o.offset_);
+        std::swap(column_, o.column_);
+        std::swap(slot_, o.slot_);
+    }
+
+    unsigned long nRow() const { return nRow_; }
+    unsigned long nnz() const { return offset_ == nullptr ? 0 : offset_[nRow_]; }
+    const unsigned long *offset() const { return offset_; }
+    const index_t *column() const { return column_; }
+    CsrView view() const { return CsrView(nRow_, offset_, column_); }
+
+    unsigned long nSlot() const { return nSlot_; }
+    const unsigned long *slot() const { return slot_; }
+
+    // (row, col)的非零元下标（行内二分查找），不在结构中时返回pattern_none
+    unsigned long find(index_t row, index_t col) const {
+        const index_t *first = column_ + offset_[row], *last = column_ + offset_[row + 1];
+        const index_t *p = std::lower_bound(first, last, col);
+        return p != last && *p == col ? p - column_ : pattern_none;
+    }
+
+    // 点-点结构：同一单元中的任意两个点相连。先按行收集每个单元的NV*NV个(行, 列)，行内排序去重后压紧
+    template <int NV>
+    void build_vertex(unsigned long nVertex, unsigned long nElement, index_t *const *elem, unsigned nthreads) {
+        clear();
+        unsigned long *raw_offset;
+        index_t *raw;
+        build_csr(nVertex, nElement, nthreads, [&](unsigned long i, auto &&sink) {
+            for (int a = 0; a < NV; ++a)
+                for (int b = 0; b < NV; ++b) sink(elem[a][i], elem[b][i]);
+        }, raw_offset, raw, arena_);
+
+        nRow_ = nVertex;
+        offset_ = arena_.allocate<unsigned long>(nVertex + 1);
+        parallel_for(0, nVertex, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+            for (unsigned long v = lo; v < hi; ++v)
+                offset_[v] = std::unique(raw + raw_offset[v], raw + raw_offset[v + 1]) - (raw + raw_offset[v]);
+        });
+        offset_[nVertex] = 0;
+        column_ = arena_.allocate<index_t>(parallel_exclusive_scan(offset_, nVertex + 1, nthreads));
+        parallel_for(0, nVertex, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+            for (unsigned long v = lo; v < hi; ++v)
+                std::copy(raw + raw_offset[v], raw + raw_offset[v] + (offset_[v + 1] - offset_[v]), column_ + offset_[v]);
+        });
+        arena_.release(raw_offset);
+        arena_.release(raw);
+
+        nSlot_ = static_cast<unsigned long>(NV) * NV * nElement;
+        slot_ = arena_.allocate<unsigned long>(nSlot_);
+        parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+            for (unsigned long i = lo; i < hi; ++i) {
+                unsigned long *out = slot_ + static_cast<unsigned long>(NV) * NV * i;
+                for (int a = 0; a < NV; ++a)
+                    for (int b = 0; b < NV; ++b) out[a * NV + b] = find(elem[a][i], elem[b][i]);
+            }
+        });
+    }
+
+    // 单元-单元结构：单元与通过内部子实体相邻的单元相连。每行为单元自身加上各相邻单元，行很短，直接插入排序
+    // conn[j][i]为单元i的第j个子实体，left/right为子实体两侧的单元（边界上right为nElement+1）
+    template <int NS>
+    void build_element(unsigned long nElement, unsigned long nSub, index_t *const *conn, const index_t *left,
+                       const index_t *right, unsigned nthreads) {
+        clear();
+        nRow_ = nElement;
+        offset_ = arena_.allocate<unsigned long>(nElement + 1);
+        parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+            for (unsigned long i = lo; i < hi; ++i) {
+                unsigned long c = 1;
+                for (int j = 0; j < NS; ++j) c += right[conn[j][i]] < nElement;
+                offset_[i] = c;
+            }
+        });
+        offset_[nElement] = 0;
+        column_ = arena_.allocate<index_t>(parallel_exclusive_scan(offset_, nElement + 1, nthreads));
+        parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+            for (unsigned long i = lo; i < hi; ++i) {
+                index_t *row = column_ + offset_[i];
+                unsigned long n = 0;
+                row[n++] = i;
+                for (int j = 0; j < NS; ++j) {
+                    index_t s = conn[j][i];
+                    if (right[s] >= nElement) continue;
+                    index_t e = left[s] == i ? right[s] : left[s];
+                    unsigned long k = n++;
+                    for (; k > 0 && row[k - 1] > e; --k) row[k] = row[k - 1];
+                    row[k] = e;
+                }
+            }
+        });
+
+        nSlot_ = 4 * nSub;
+        slot_ = arena_.allocate<unsigned long>(nSlot_);
+        parallel_for(0, nSub, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+            for (unsigned long s = lo; s < hi; ++s) {
+                index_t l = left[s], r = right[s];
+                unsigned long *out = slot_ + 4 * s;
+                out[0] = find(l, l);
+                if (r >= nElement) {
+                    out[1] = out[2] = out[3] = pattern_none;
+                } else {
+                    out[1] = find(l, r);
+                    out[2] = find(r, l);
+                    out[3] = find(r, r);
+                }
+            }
+        });
+    }
+
+private:
+    void clear() {
+        arena_.release(offset_);
+        arena_.release(column_);
+        arena_.release(slot_);
+        nRow_ = nSlot_ = 0;
+    }
+
+    ArrayArena arena_;
+    unsigned long nRow_, nSlot_;
+    unsigned long *offset_;
+    index_t *column_;
+    unsigned long *slot_;
+};
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_SPARSITY_H
@@ -0,0 +1,592 @@
+#ifndef MESH_STRUCTURE_SPATIAL_INDEX_H
+#define MESH_STRUCTURE_SPATIAL_INDEX_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "mesh_structure/ElementTraits.h"
+#include "mesh_structure/Index.h"
+#include "mesh_structure/Parallel.h"
+
+namespace mesh_structure {
+
+// 包围盒层次(BVH)：按分箱SAH自顶向下构建，叶子最多leaf_size个条目
+// 节点连续存放，内部节点的两个子节点相邻（first, first+1）；构建是串行的，查询只读，可在多个线程中同时进行
+class Bvh {
+public:
+    struct Node {
+        double lo[3], hi[3];
+        index_t first;   // 内部节点：左子节点；叶子：第一个条目在items()中的位置
+        index_t count;   // 叶子的条目数，内部节点为0
+    };
+
+    // 由n个条目的包围盒lo[d][i]、hi[d][i]构建
+    void build(unsigned long n, const double *const *lo, const double *const *hi, unsigned leaf_size) {
+        check_index_range(2 * n, "BVH nodes");
+        nodes_.clear();
+        item_.resize(n);
+        std::vector<double> centroid[3];
+        for (int d = 0; d < 3; ++d) {
+            centroid[d].resize(n);
+            for (unsigned long i = 0; i < n; ++i) centroid[d][i] = 0.5 * (lo[d][i] + hi[d][i]);
+        }
+        for (unsigned long i = 0; i < n; ++i) item_[i] = i;
+        if (n == 0) return;
+        nodes_.reserve(2 * n / std::max(leaf_size, 1u) + 1);
+        nodes_.push_back(Node());
+
+        struct Task { unsigned long node, begin, end; unsigned depth; };
+        std::vector<Task> stack(1, Task{0, 0, n, 0});
+        depth_ = 0;
+        while (!stack.empty()) {
+            Task t = stack.back();
+            stack.pop_back();
+            depth_ = std::max(depth_, t.depth);
+            Node node;
+            double clo[3], chi[3];
+            for (int d = 0; d < 3; ++d) {
+                node.lo[d] = clo[d] = 1e300;
+                node.hi[d] = chi[d] = -1e300;
+            }
+            for (unsigned long k = t.begin; k < t.end; ++k) {
+                index_t i = item_[k];
+                for (int d = 0; d < 3; ++d) {
+                    node.lo[d] = std::min(node.lo[d], lo[d][i]);
+                    node.hi[d] = std::max(node.hi[d], hi[d][i]);
+                    clo[d] = std::min(clo[d], centroid[d][i]);
+                    chi[d] = std::max(chi[d], centroid[d][i]);
+                }
+            }
+            unsigned long count = t.end - t.begin;
+            unsigned long mid = count <= leaf_size ? t.begin : split(t.begin, t.end, clo, chi, centroid, lo, hi);
+            if (mid == t.begin) {
+                node.first = t.begin;
+                node.count = count;
+                nodes_[t.node] = node;
+                continue;
+            }
+            node.first = nodes_.size();
+            node.count = 0;
+            nodes_[t.node] = node;
+            nodes_.push_back(Node());
+            nodes_.push_back(Node());
+            stack.push_back(Task{node.first + 1ul, mid, t.end, t.depth + 1});
+            stack.push_back(Task{node.first, t.begin, mid, t.depth + 1});
+        }
+    }
+
+    const std::vector<Node> &nodes() const { return nodes_; }
+    const index_t *items() const { return item_.data(); }
+    bool empty() const { return nodes_.empty(); }
+    unsigned depth() const { return depth_; }
+
+    // 深度优先遍历用的栈：树不太深时放在栈上，否则在堆上分配
+    class Stack {
+    public:
+        explicit Stack(const Bvh &bvh) : p_(local_), top_(0) {
+            if (bvh.depth_ + 2 > 64) {
+                heap_.resize(bvh.depth_ + 2);
+                p_ = heap_.data();
+            }
+        }
+        void push(index_t n) { p_[top_++] = n; }
+        index_t pop() { return p_[--top_]; }
+        bool empty() const { return top_ == 0; }
+    private:
+        index_t local_[64];
+        std::vector<index_t> heap_;
+        index_t *p_;
+        unsigned top_;
+    };
+
+    // 点到包围盒的距离的平方，点在盒内时为0
+    static double box_distance2(const Node &b, const double *p) {
+        double s = 0;
+        for (int d = 0; d < 3; ++d) {
+            double e = std::max(std::max(b.lo[d] - p[d], p[d] - b.hi[d]), 0.0);
+            s += e * e;
+        }
+        return s;
+    }
+
+private:
+    static constexpr int nbins = 16;
+
+    // 在分箱SAH代价最小处划分[begin, end)，返回分界位置；全部形心重合时对半分
+    unsigned long split(unsigned long begin, unsigned long end, const double *clo, const double *chi,
+                        const std::vector<double> *centroid, const double *const *lo, const double *const *hi) {
+        struct Bin { double lo[3], hi[3]; unsigned long n; };
+        auto area = [](const double *l, const double *h) {
+            double e[3];
+            for (int d = 0; d < 3; ++d) e[d] = std::max(h[d] - l[d], 0.0);
+            return e[0] * e[1] + e[1] * e[2] + e[2] * e[0];
+        };
+        double best = 1e300;
+        int best_axis = -1, best_bin = 0;
+        for (int d = 0; d < 3; ++d) {
+            if (!(chi[d] > clo[d])) continue;
+            Bin bin[nbins];
+            for (Bin &b : bin) {
+                for (int a = 0; a < 3; ++a) { b.lo[a] = 1e300; b.hi[a] = -1e300; }
+                b.n = 0;
+            }
+            double scale = nbins / (chi[d] - clo[d]);
+            for (unsigned long k = begin; k < end; ++k) {
+                index_t i = item_[k];
+                int b = std::min(static_cast<int>((centroid[d][i] - clo[d]) * scale), nbins - 1);
+                for (int a = 0; a < 3; ++a) {
+                    bin[b].lo[a] = std::min(bin[b].lo[a], lo[a][i]);
+                    bin[b].hi[a] = std::max(bin[b].hi[a], hi[a][i]);
+                }
+                ++bin[b].n;
+            }
+            // 从右向左累计右侧的面积和条目数，再从左向右计算各分界的代价
+            double right_area[nbins];
+            double rl[3] = {1e300, 1e300, 1e300}, rh[3] = {-1e300, -1e300, -1e300};
+            for (int b = nbins - 1; b > 0; --b) {
+                for (int a = 0; a < 3; ++a) {
+                    rl[a] = std::min(rl[a], bin[b].lo[a]);
+                    rh[a] = std::max(rh[a], bin[b].hi[a]);
+                }
+                right_area[b] = area(rl, rh);
+            }
+            double ll[3] = {1e300, 1e300, 1e300}, lh[3] = {-1e300, -1e300, -1e300};
+            unsigned long nl = 0;
+            for (int b = 0; b < nbins - 1; ++b) {
+                for (int a = 0; a < 3; ++a) {
+                    ll[a] = std::min(ll[a], bin[b].lo[a]);
+                    lh[a] = std::max(lh[a], bin[b].hi[a]);
+                }
+                nl += bin[b].n;
+                unsigned long nr = end - begin - nl;
+                if (nl == 0 || nr == 0) continue;
+                double cost = area(ll, lh) * nl + right_area[b + 1] * nr;
+                if (cost < best) {
+                    best = cost;
+                    best_axis = d;
+                    best_bin = b;
+                }
+            }
+        }
+        if (best_axis < 0) return begin + (end - begin) / 2;
+        int d = best_axis;
+        double scale = nbins / (chi[d] - clo[d]);
+        index_t *m = std::partition(item_.data() + begin, item_.data() + end, [&](index_t i) {
+            return std::min(static_cast<int>((centroid[d][i] - clo[d]) * scale), nbins - 1) <= best_bin;
+        });
+        return m - item_.data();
+    }
+
+    std::vector<Node> nodes_;
+    std::vector<index_t> item_;
+    unsigned depth_ = 0;
+};
+
+
+namespace detail {
+
+// 点p在三角形abc上的最近点，返回距离的平方，bary为最近点的重心坐标（Ericson, Real-Time Collision Detection 5.1.5）
+inline double closest_on_triangle(const double *p, const double *a, const double *b, const double *c, double *bary) {
+    double ab[3], ac[3], ap[3];
+    for (int d = 0; d < 3; ++d) {
+        ab[d] = b[d] - a[d];
+        ac[d] = c[d] - a[d];
+        ap[d] = p[d] - a[d];
+    }
+    auto dot = [](const double *u, const double *v) { return u[0] * v[0] + u[1] * v[1] + u[2] * v[2]; };
+    double d1 = dot(ab, ap), d2 = dot(ac, ap);
+    double u, v, w;
+    if (d1 <= 0 && d2 <= 0) {
+        u = 1; v = 0; w = 0;
+    } else {
+        double bp[3], cp[3];
+        for (int d = 0; d < 3; ++d) {
+            bp[d] = p[d] - b[d];
+            cp[d] = p[d] - c[d];
+        }
+        double d3 = dot(ab, bp), d4 = dot(ac, bp), d5 = dot(ab, cp), d6 = dot(ac, cp);
+        double vc = d1 * d4 - d3 * d2, vb = d5 * d2 - d1 * d6, va = d3 * d6 - d5 * d4;
+        if (d3 >= 0 && d4 <= d3) {
+            u = 0; v = 1; w = 0;
+        } else if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+            v = d1 / (d1 - d3); u = 1 - v; w = 0;
+        } else if (d6 >= 0 && d5 <= d6) {
+            u = 0; v = 0; w = 1;
+        } else if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+            w = d2 / (d2 - d6); u = 1 - w; v = 0;
+        } else if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0) {
+            w = (d4 - d3) / ((d4 - d3) + (d5 - d6)); u = 0; v = 1 - w;
+        } else {
+            double s = va + vb + vc;
+            v = vb / s; w = vc / s; u = 1 - v - w;
+        }
+    }
+    bary[0] = u; bary[1] = v; bary[2] = w;
+    double s = 0;
+    for (int d = 0; d < 3; ++d) {
+        double e = p[d] - (u * a[d] + v * b[d] + w * c[d]);
+        s += e * e;
+    }
+    return s;
+}
+
+// 点p关于三角形abc所在平面上投影的重心坐标，返回p到平面的距离的平方；退化三角形返回负值
+inline double triangle_barycentric(const double *p, const double *a, const double *b, const double *c, double *bary) {
+    double v0[3], v1[3], v2[3];
+    for (int d = 0; d < 3; ++d) {
+        v0[d] = b[d] - a[d];
+        v1[d] = c[d] - a[d];
+        v2[d] = p[d] - a[d];
+    }
+    auto dot = [](const double *u, const double *v) { return u[0] * v[0] + u[1] * v[1] + u[2] * v[2]; };
+    double d00 = dot(v0, v0), d01 = dot(v0, v1), d11 = dot(v1, v1), d20 = dot(v2, v0), d21 = dot(v2, v1);
+    double den = d00 * d11 - d01 * d01;
+    if (!(den > 0)) return -1;
+    bary[1] = (d11 * d20 - d01 * d21) / den;
+    bary[2] = (d00 * d21 - d01 * d20) / den;
+    bary[0] = 1 - bary[1] - bary[2];
+    double s = 0;
+    for (int d = 0; d < 3; ++d) {
+        double e = v2[d] - bary[1] * v0[d] - bary[2] * v1[d];
+        s += e * e;
+    }
+    return s;
+}
+
+// 点p关于四面体abcd的重心坐标（Cramer法则），退化四面体返回false
+inline bool tetrahedron_barycentric(const double *p, const double *a, const double *b, const double *c,
+                                    const double *d, double *bary) {
+    double e1[3], e2[3], e3[3], r[3];
+    for (int k = 0; k < 3; ++k) {
+        e1[k] = b[k] - a[k];
+        e2[k] = c[k] - a[k];
+        e3[k] = d[k] - a[k];
+        r[k] = p[k] - a[k];
+    }
+    auto det = [](const double *u, const double *v, const double *w) {
+        return u[0] * (v[1] * w[2] - v[2] * w[1]) - u[1] * (v[0] * w[2] - v[2] * w[0]) +
+               u[2] * (v[0] * w[1] - v[1] * w[0]);
+    };
+    double vol = det(e1, e2, e3);
+    if (vol == 0) return false;
+    bary[1] = det(r, e2, e3) / vol;
+    bary[2] = det(e1, r, e3) / vol;
+    bary[3] = det(e1, e2, r) / vol;
+    bary[0] = 1 - bary[1] - bary[2] - bary[3];
+    return true;
+}
+
+}  // namespace detail
+
+
+// 单纯形网格（三角形、四面体）的点定位和最近单元查询，基于单元包围盒的BVH
+// 构建时按叶子顺序复制各单元的顶点坐标（每个四面体96字节），查询时顺序访问，不再引用网格的数组；
+// 网格修改或重排后需重新build。查询函数是只读的，批量版本按点并行
+template <class Traits>
+class ElementLocator {
+    static_assert(Traits::nv == Traits::dim + 1, "ElementLocator supports triangles and tetrahedra only");
+
+public:
+    static constexpr int NV = Traits::nv;
+
+    ElementLocator() : nElement_(0), diag_(0) {}
+
+    void build(unsigned long nElement, const double *x, const double *y, const double *z,
+               const index_t *const *elem, unsigned nthreads = 0) {
+        nElement_ = nElement;
+        std::vector<double> lo[3], hi[3];
+        for (int d = 0; d < 3; ++d) {
+            lo[d].resize(nElement);
+            hi[d].resize(nElement);
+        }
+        const double *c[3] = {x, y, z};
+        parallel_for(0, nElement, resolve_threads(nthreads), [&](unsigned long b, unsigned long e, unsigned) {
+            for (unsigned long i = b; i < e; ++i) {
+                for (int d = 0; d < 3; ++d) {
+                    double l = c[d][elem[0][i]], h = l;
+                    for (int j = 1; j < NV; ++j) {
+                        l = std::min(l, c[d][elem[j][i]]);
+                        h = std::max(h, c[d][elem[j][i]]);
+                    }
+                    lo[d][i] = l;
+                    hi[d][i] = h;
+                }
+            }
+        });
+        const double *l[3] = {lo[0].data(), lo[1].data(), lo[2].data()};
+        const double *h[3] = {hi[0].data(), hi[1].data(), hi[2].data()};
+        bvh_.build(nElement, l, h, 4);
+        coord_.resize(nElement * NV * 3);
+        parallel_for(0, nElement, resolve_threads(nthreads), [&](unsigned long b, unsigned long e, unsigned) {
+            for (unsigned long k = b; k < e; ++k) {
+                index_t i = bvh_.items()[k];
+                for (int j = 0; j < NV; ++j)
+                    for (int d = 0; d < 3; ++d) coord_[(k * NV + j) * 3 + d] = c[d][elem[j][i]];
+            }
+        });
+        diag_ = 0;
+        if (!bvh_.empty()) {
+            const Bvh::Node &root = bvh_.nodes()[0];
+            for (int d = 0; d < 3; ++d) diag_ += (root.hi[d] - root.lo[d]) * (root.hi[d] - root.lo[d]);
+            diag_ = std::sqrt(diag_);
+        }
+    }
+
+    // 包含点p的单元，找不到时返回nElement+1；bary（可为nullptr）返回NV个重心坐标，找不到时不写
+    // 四面体：各重心坐标不小于-tol；三角形：p到三角形所在平面的距离不超过tol乘以网格包围盒的对角线长，
+    // 且投影点的各重心坐标不小于-tol。点在公共边界上时返回其中一个单元
+    unsigned long locate(const double *p, double *bary = nullptr, double tol = 1e-10) const {
+        double b[NV] = {};
+        double margin = tol * diag_;
+        unsigned long found = nElement_ + 1;
+        traverse(p, margin, [&](index_t k) {
+            if (!contains(k, p, tol, margin, b)) return false;
+            found = bvh_.items()[k];
+            return true;
+        });
+        if (found <= nElement_ && bary != nullptr) std::copy(b, b + NV, bary);
+        return found;
+    }
+
+    // 离点p最近的单元（点在单元内时距离为0），返回单元编号，网格为空时返回nElement+1
+    // bary（可为nullptr）返回单元上最近点的重心坐标，dist2（可为nullptr）返回距离的平方；网格为空时两者都不写
+    unsigned long nearest(const double *p, double *bary = nullptr, double *dist2 = nullptr) const {
+        const std::vector<Bvh::Node> &nodes = bvh_.nodes();
+        unsigned long found = nElement_ + 1;
+        double best = 1e300, b[NV] = {}, bb[NV] = {};
+        if (nodes.empty()) return found;
+        // 深度优先，先访问较近的子节点，跳过比当前最优更远的节点
+        Bvh::Stack stack(bvh_);
+        stack.push(0);
+        while (!stack.empty()) {
+            const Bvh::Node &n = nodes[stack.pop()];
+            if (Bvh::box_distance2(n, p) >= best) continue;
+            if (n.count != 0) {
+                for (index_t k = n.first; k < n.first + n.count; ++k) {
+                    double s = closest(k, p, b);
+                    if (s < best) {
+                        best = s;
+                        found = bvh_.items()[k];
+                        std::copy(b, b + NV, bb);
+                    }
+                }
+                continue;
+            }
+            double dl = Bvh::box_distance2(nodes[n.first], p), dr = Bvh::box_distance2(nodes[n.first + 1], p);
+            if (dl <= dr) {
+                stack.push(n.first + 1);
+                stack.push(n.first);
+            } else {
+                stack.push(n.first);
+                stack.push(n.first + 1);
+            }
+        }
+        if (bary != nullptr) std::copy(bb, bb + NV, bary);
+        if (dist2 != nullptr) *dist2 = best;
+        return found;
+    }
+
+    // 批量定位n个点(px[k], py[k], pz[k])：elem_out[k]为所在单元（找不到时为nElement+1），
+    // bary（可为nullptr）为NV个数组，bary[j][k]为第k个点的第j个重心坐标，找不到的点为NaN
+    void locate(unsigned long n, const double *px, const double *py, const double *pz, index_t *elem_out,
+                double *const *bary, unsigned nthreads = 0, double tol = 1e-10) const {
+        parallel_for(0, n, resolve_threads(nthreads), [&](unsigned long lo, unsigned long hi, unsigned) {
+            double b[NV] = {};
+            for (unsigned long k = lo; k < hi; ++k) {
+                double p[3] = {px[k], py[k], pz[k]};
+                elem_out[k] = locate(p, b, tol);
+                if (elem_out[k] > nElement_) std::fill(b, b + NV, std::numeric_limits<double>::quiet_NaN());
+                if (bary != nullptr)
+                    for (int j = 0; j < NV; ++j) bary[j][k] = b[j];
+            }
+        });
+    }
+
+    // 批量最近单元，参数含义同上，dist2（可为nullptr）为距离的平方；网格为空时重心坐标为NaN，距离的平方为1e300
+    void nearest(unsigned long n, const double *px, const double *py, const double *pz, index_t *elem_out,
+                 double *const *bary, double *dist2, unsigned nthreads = 0) const {
+        parallel_for(0, n, resolve_threads(nthreads), [&](unsigned long lo, unsigned long hi, unsigned) {
+            double b[NV] = {}, s = 1e300;
+            for (unsigned long k = lo; k < hi; ++k) {
+                double p[3] = {px[k], py[k], pz[k]};
+                elem_out[k] = nearest(p, b, &s);
+                if (elem_out[k] > nElement_) {
+                    std::fill(b, b + NV, std::numeric_limits<double>::quiet_NaN());
+                    s = 1e300;
+                }
+                if (bary != nullptr)
+                    for (int j = 0; j < NV; ++j) bary[j][k] = b[j];
+                if (dist2 != nullptr) dist2[k] = s;
+            }
+        });
+    }
+
+private:
+    // 叶子顺序中第k个单元的第j个顶点
+    const double *vertex(index_t k, int j) const { return coord_.data() + (static_cast<unsigned long>(k) * NV + j) * 3; }
+
+    // 访问包围盒（放大margin后）包含p的叶子中的单元（按叶子顺序的位置），visit返回true时停止
+    template <class Visit>
+    void traverse(const double *p, double margin, Visit &&visit) const {
+        const std::vector<Bvh::Node> &nodes = bvh_.nodes();
+        if (nodes.empty()) return;
+        Bvh::Stack stack(bvh_);
+        stack.push(0);
+        while (!stack.empty()) {
+            const Bvh::Node &n = nodes[stack.pop()];
+            bool inside = true;
+            for (int d = 0; d < 3; ++d)
+                inside = inside && p[d] >= n.lo[d] - margin && p[d] <= n.hi[d] + margin;
+            if (!inside) continue;
+            if (n.count != 0) {
+                for (index_t k = n.first; k < n.first + n.count; ++k)
+                    if (visit(k)) return;
+            } else {
+                stack.push(n.first + 1);
+                stack.push(n.first);
+            }
+        }
+    }
+
+    bool contains(index_t k, const double *p, double tol, double margin, double *b) const {
+        const double *v[NV];
+        for (int j = 0; j < NV; ++j) v[j] = vertex(k, j);
+        if constexpr (NV == 4) {
+            if (!detail::tetrahedron_barycentric(p, v[0], v[1], v[2], v[3], b)) return false;
+        } else {
+            double s = detail::triangle_barycentric(p, v[0], v[1], v[2], b);
+            if (s < 0 || s > margin * margin) return false;
+        }
+        for (int j = 0; j < NV; ++j)
+            if (b[j] < -tol) return false;
+        return true;
+    }
+
+    // 叶子顺序中第k个单元上离p最近的点，返回距离的平方
+    double closest(index_t k, const double *p, double *b) const {
+        const double *v[NV];
+        for (int j = 0; j < NV; ++j) v[j] = vertex(k, j);
+        if constexpr (NV == 3) {
+            return detail::closest_on_triangle(p, v[0], v[1], v[2], b);
+        } else {
+            if (detail::tetrahedron_barycentric(p, v[0], v[1], v[2], v[3], b) && *std::min_element(b, b + NV) >= 0)
+                return 0;
+            // 在外部时最近点位于某个面上
+            double best = 1e300, fb[3];
+            for (int f = 0; f < Traits::ns; ++f) {
+                const int *l = Traits::local[f];
+                double s = detail::closest_on_triangle(p, v[l[0]], v[l[1]], v[l[2]], fb);
+                if (s < best) {
+                    best = s;
+                    for (int j = 0; j < NV; ++j) b[j] = 0;
+                    for (int a = 0; a < 3; ++a) b[l[a]] = fb[a];
+                }
+            }
+            return best;
+        }
+    }
+
+    unsigned long nElement_;
+    double diag_;
+    Bvh bvh_;
+    std::vector<double> coord_;   // 按叶子顺序的单元顶点坐标
+};
+
+
+// 网格点的k近邻查询，基于点的BVH；构建时按叶子顺序复制坐标，查询只读，批量版本按点并行
+class VertexSearch {
+public:
+    VertexSearch() : nVertex_(0) {}
+
+    void build(unsigned long nVertex, const double *x, const double *y, const double *z) {
+        nVertex_ = nVertex;
+        const double *c[3] = {x, y, z};
+        bvh_.build(nVertex, c, c, 8);
+        coord_.resize(3 * nVertex);
+        for (unsigned long k = 0; k < nVertex; ++k)
+            for (int d = 0; d < 3; ++d) coord_[3 * k + d] = c[d][bvh_.items()[k]];
+    }
+
+    // 离p最近的k个点，按距离升序写入index和dist2（dist2可为nullptr），返回找到的个数min(k, nVertex)
+    unsigned long nearest(const double *p, unsigned long k, index_t *index, double *dist2 = nullptr) const {
+        std::vector<std::pair<double, index_t>> heap;
+        return nearest(p, k, index, dist2, heap);
+    }
+
+    // 批量k近邻：第q个查询点的结果存放在index[q*k .. q*k+k)和dist2[q*k .. q*k+k)（dist2可为nullptr），
+    // 点数少于k时不足的位置填nVertex
+    void nearest(unsigned long n, const double *px, const double *py, const double *pz, unsigned long k,
+                 index_t *index, double *dist2, unsigned nthreads = 0) const {
+        parallel_for(0, n, resolve_threads(nthreads), [&](unsigned long lo, unsigned long hi, unsigned) {
+            std::vector<std::pair<double, index_t>> heap;
+            for (unsigned long q = lo; q < hi; ++q) {
+                double p[3] = {px[q], py[q], pz[q]};
+                unsigned long m = nearest(p, k, index + q * k, dist2 == nullptr ? nullptr : dist2 + q * k, heap);
+                for (; m < k; ++m) {
+                    index[q * k + m] = nVertex_;
+                    if (dist2 != nullptr) dist2[q * k + m] = 1e300;
+                }
+            }
+        });
+    }
+
+private:
+    // heap为调用者提供的工作区，批量查询时重复使用
+    unsigned long nearest(const double *p, unsigned long k, index_t *index, double *dist2,
+                          std::vector<std::pair<double, index_t>> &heap) const {
+        const std::vector<Bvh::Node> &nodes = bvh_.nodes();
+        if (nodes.empty() || k == 0) return 0;
+        // 当前的k个候选组成按距离的最大堆
+        heap.clear();
+        heap.reserve(k);
+        auto worst = [&]() { return heap.size() < k ? 1e300 : heap.front().first; };
+        Bvh::Stack stack(bvh_);
+        stack.push(0);
+        while (!stack.empty()) {
+            const Bvh::Node &n = nodes[stack.pop()];
+            if (Bvh::box_distance2(n, p) > worst()) continue;
+            if (n.count != 0) {
+                for (index_t m = n.first; m < n.first + n.count; ++m) {
+                    index_t v = bvh_.items()[m];
+                    const double *c = coord_.data() + 3ul * m;
+                    double dx = c[0] - p[0], dy = c[1] - p[1], dz = c[2] - p[2];
+                    double s = dx * dx + dy * dy + dz * dz;
+                    if (heap.size() < k) {
+                        heap.emplace_back(s, v);
+                        std::push_heap(heap.begin(), heap.end());
+                    } else if (std::make_pair(s, v) < heap.front()) {
+                        std::pop_heap(heap.begin(), heap.end());
+                        heap.back() = std::make_pair(s, v);
+                        std::push_heap(heap.begin(), heap.end());
+                    }
+                }
+                continue;
+            }
+            double dl = Bvh::box_distance2(nodes[n.first], p), dr = Bvh::box_distance2(nodes[n.first + 1], p);
+            if (dl <= dr) {
+                stack.push(n.first + 1);
+                stack.push(n.first);
+            } else {
+                stack.push(n.first);
+                stack.push(n.first + 1);
+            }
+        }
+        std::sort_heap(heap.begin(), heap.end());
+        for (unsigned long m = 0; m < heap.size(); ++m) {
+            index[m] = heap[m].second;
+            if (dist2 != nullptr) dist2[m] = heap[m].first;
+        }
+        return heap.size();
+    }
+
+    unsigned long nVertex_;
+    Bvh bvh_;
+    std::vector<double> coord_;   // 按叶子顺序的点坐标
+};
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_SPATIAL_INDEX_H
@@ -0,0 +1,121 @@
+#ifndef MESH_STRUCTURE_STATS_H
+#define MESH_STRUCTURE_STATS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "mesh_structure/Arena.h"
+#include "mesh_structure/Error.h"
+
+namespace mesh_structure {
+
+// 一个阶段（如read_off、collect_sub_entities）的累计统计
+// 字节数只计网格存储区中的数组，不含快照映射和各阶段内部临时的std::vector
+struct PhaseStats {
+    std::string name;
+    unsigned long calls = 0;
+    double seconds = 0;          // 全部调用的总耗时
+    double last_seconds = 0;     // 最后一次调用的耗时
+    size_t peak_bytes = 0;       // 调用过程中存储区使用量比调用开始时多出的最大值，各次调用取最大
+    long long net_bytes = 0;     // 最后一次调用结束时存储区使用量的变化，释放多于分配时为负
+};
+
+// 网格各阶段的统计，按第一次调用的顺序排列（见Mesh::enable_stats）
+class MeshStats {
+public:
+    const std::vector<PhaseStats> &phases() const { return phases_; }
+
+    // 按名称查找，没有调用过时返回nullptr
+    const PhaseStats *find(const std::string &name) const {
+        for (const PhaseStats &p : phases_)
+            if (p.name == name) return &p;
+        return nullptr;
+    }
+
+    void clear() { phases_.clear(); }
+
+    // 记入一次调用
+    void record(const char *name, double seconds, size_t peak_bytes, long long net_bytes) {
+        auto it = std::find_if(phases_.begin(), phases_.end(), [&](const PhaseStats &p) { return p.name == name; });
+        if (it == phases_.end()) {
+            phases_.emplace_back();
+            phases_.back().name = name;
+            it = phases_.end() - 1;
+        }
+        ++it->calls;
+        it->seconds += seconds;
+        it->last_seconds = seconds;
+        it->peak_bytes = std::max(it->peak_bytes, peak_bytes);
+        it->net_bytes = net_bytes;
+    }
+
+    std::string to_json() const {
+        std::string s = "{\n  \"phases\": [\n";
+        char buf[256];
+        for (size_t k = 0; k < phases_.size(); ++k) {
+            const PhaseStats &p = phases_[k];
+            std::snprintf(buf, sizeof(buf),
+                          "\", \"calls\": %lu, \"seconds\": %.9g, \"last_seconds\": %.9g, "
+                          "\"peak_bytes\": %zu, \"net_bytes\": %lld}%s\n",
+                          p.calls, p.seconds, p.last_seconds, p.peak_bytes, p.net_bytes,
+                          k + 1 < phases_.size() ? "," : "");
+            s += "    {\"name\": \"" + p.name + buf;
+        }
+        return s + "  ]\n}\n";
+    }
+
+    void write_json(const std::string &path) const {
+        std::FILE *f = std::fopen(path.c_str(), "w");
+        if (f == nullptr) {
+            throw FileError(path, "Cannot open output file");
+        }
+        std::string s = to_json();
+        bool ok = std::fwrite(s.data(), 1, s.size(), f) == s.size();
+        if (std::fclose(f) != 0 || !ok) {
+            throw FileError(path, "Failed to write output file");
+        }
+    }
+
+private:
+    std::vector<PhaseStats> phases_;
+};
+
+// 作用域计时：构造时开始，析构时把耗时和存储区的用量记入stats；stats为nullptr（未开启统计）时什么也不做
+// 阶段可以嵌套：进入时把存储区的峰值重置为当前用量，退出时恢复为外层的峰值与本阶段峰值中较大的
+class ScopedPhase {
+public:
+    ScopedPhase(MeshStats *stats, const char *name, ArrayArena &arena)
+        : stats_(stats), name_(name), arena_(arena) {
+        if (stats_ == nullptr) return;
+        outer_peak_ = arena_.bytes_peak();
+        start_bytes_ = arena_.bytes_in_use();
+        arena_.set_peak(start_bytes_);
+        start_ = std::chrono::steady_clock::now();
+    }
+
+    ~ScopedPhase() {
+        if (stats_ == nullptr) return;
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+        size_t peak = arena_.bytes_peak();
+        stats_->record(name_, seconds, peak - start_bytes_,
+                       static_cast<long long>(arena_.bytes_in_use()) - static_cast<long long>(start_bytes_));
+        arena_.set_peak(std::max(outer_peak_, peak));
+    }
+
+    ScopedPhase(const ScopedPhase &) = delete;
+    ScopedPhase &operator=(const ScopedPhase &) = delete;
+
+private:
+    MeshStats *stats_;
+    const char *name_;
+    ArrayArena &arena_;
+    size_t outer_peak_ = 0, start_bytes_ = 0;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_STATS_H
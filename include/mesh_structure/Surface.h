@@ -0,0 +1,21 @@
+#ifndef MESH_STRUCTURE_SURFACE_H
+#define MESH_STRUCTURE_SURFACE_H
+
+#include <vector>
+
+#include "mesh_structure/Index.h"
+
+namespace mesh_structure {
+
+// 体网格的边界曲面与体网格之间的编号映射（曲面本身见Mesh::extract_boundary）
+struct SurfaceMap {
+    std::vector<index_t> vertex_volume;   // 曲面点 -> 体网格的点，按体网格编号升序
+    std::vector<index_t> face_volume;     // 曲面单元 -> 体网格的边界子实体，与boundary()的顺序相同
+    std::vector<index_t> face_element;    // 曲面单元 -> 它所在的体单元
+    std::vector<index_t> patch;           // 曲面单元所属的面片，不分组时为空
+    unsigned long nPatch = 0;
+};
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_SURFACE_H
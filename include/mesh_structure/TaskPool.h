@@ -0,0 +1,128 @@
+#ifndef MESH_STRUCTURE_TASK_POOL_H
+#define MESH_STRUCTURE_TASK_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "mesh_structure/Parallel.h"
+
+namespace mesh_structure {
+
+// 工作窃取线程池：每个工作线程有自己的任务队列，从队尾取自己的任务（后进先出，刚产生的后续任务
+// 留在同一线程上，数据还在缓存中），自己的队列为空时从其他线程的队头窃取（先进先出，取走最早的任务）
+// 工作线程中提交的任务放入自己的队列，其他线程提交的任务轮流放入各队列
+// 任务不应抛出异常，需要报告错误时由任务自己捕获（如写入std::promise）
+class TaskPool {
+public:
+    explicit TaskPool(unsigned nthreads = 0) : queues_(resolve_threads(nthreads)) {
+        for (auto &q : queues_) q.reset(new Queue);
+        for (unsigned t = 0; t < queues_.size(); ++t) workers_.emplace_back([this, t] { work(t); });
+    }
+
+    // 等待全部任务完成后结束工作线程
+    ~TaskPool() {
+        wait();
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread &w : workers_) w.join();
+    }
+
+    TaskPool(const TaskPool &) = delete;
+    TaskPool &operator=(const TaskPool &) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(queues_.size()); }
+
+    void push(std::function<void()> task) {
+        unsigned q = current_ == this ? current_index_ : next_.fetch_add(1, std::memory_order_relaxed) % size();
+        outstanding_.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(queues_[q]->mutex);
+            queues_[q]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            ++queued_;
+        }
+        wake_.notify_one();
+    }
+
+    // 等待已提交的任务（包括它们在执行中提交的任务）全部完成；不能在工作线程中调用
+    void wait() {
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        idle_.wait(lock, [&] { return outstanding_.load() == 0; });
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    // 先取自己队尾的任务，再依次窃取其他队列队头的任务
+    bool take(unsigned t, std::function<void()> &task) {
+        for (unsigned k = 0; k < size(); ++k) {
+            Queue &q = *queues_[(t + k) % size()];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.tasks.empty()) continue;
+            if (k == 0) {
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            } else {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void work(unsigned t) {
+        current_ = this;
+        current_index_ = t;
+        std::function<void()> task;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(sleep_mutex_);
+                wake_.wait(lock, [&] { return queued_ != 0 || stop_; });
+                if (queued_ == 0) return;
+                --queued_;
+            }
+            // queued_已为本线程预留了一个任务，它一定在某个队列中
+            while (!take(t, task)) std::this_thread::yield();
+            task();
+            task = nullptr;
+            if (outstanding_.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(sleep_mutex_);
+                idle_.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<unsigned> next_{0};
+    std::atomic<unsigned long> outstanding_{0};   // 已提交但尚未完成的任务数
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_, idle_;
+    unsigned long queued_ = 0;                    // 队列中尚未被工作线程认领的任务数
+    bool stop_ = false;
+
+    static thread_local TaskPool *current_;
+    static thread_local unsigned current_index_;
+};
+
+inline thread_local TaskPool *TaskPool::current_ = nullptr;
+inline thread_local unsigned TaskPool::current_index_ = 0;
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_TASK_POOL_H
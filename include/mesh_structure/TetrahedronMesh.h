@@ -10,113 +10,51 @@
 #include <cassert>
 #include <algorithm>
 
-using namespace std;
-
-class TetrahedronMesh {
-
-private:
-    unsigned long nVertex;       // 顶点数
-    unsigned long nEdge;         // 边数
-    unsigned long nFace;         // 面数
-    unsigned long nTetrahedron;  // 四面体数
-    unsigned long nBoundary;     // 边界数
-
-    double *x_;
-    double *y_;
-    double *z_;
-    unsigned long *boundary_;
-
-    unsigned long *tet_[4];
-    unsigned long *tet_face_conn_[4];
-    unsigned long *faces_[5];  // index of 3 vertices and 2 neighboring tetrahedron for each edge
-    unsigned long *face_order_in_tet_[2];    // order of edge in 2 neighboring tetrahedron
-
-
-    // 标准C++不提供去除首尾空格的库函数，但利用string也可以实现此功能
-    string trim(string s);
-
-    bool splitOff(const string &str, const string &pattern, int n, string *res);
+#include "mesh_structure/Mesh.h"
 
-    void check_point_order(unsigned long ik, double* var);  // 用于判断点的排序
+using namespace std;
 
+// 四面体网格，子实体为面
+// 实现在Mesh<TetrahedronTraits>中（见Mesh.h），这里只提供按四面体命名的接口
+class TetrahedronMesh : public mesh_structure::Mesh<mesh_structure::TetrahedronTraits> {
 public:
-    TetrahedronMesh(){
-        nVertex=0;
-        nEdge=0;
-        nFace=0;
-        nTetrahedron=0;
-        nBoundary=0;
+    // 深拷贝，见Mesh::clone_from
+    TetrahedronMesh clone() const { TetrahedronMesh m; m.clone_from(*this); return m; }
 
-        x_=nullptr;
-        y_=nullptr;
-        z_=nullptr;
+    unsigned long getNFace(){  return nSub; }
+    unsigned long getNEdge(){  return nEdge; }
+    unsigned long getNTetrahedron() { return nElement; }
 
-        tet_[0]=tet_[1]=tet_[2]=tet_[3]=nullptr;
-        tet_face_conn_[0]=tet_face_conn_[1]=tet_face_conn_[2]=tet_face_conn_[3]=nullptr;
-        faces_[0]=faces_[1]=faces_[2]=faces_[3]=faces_[4]=nullptr;
-        face_order_in_tet_[0]=face_order_in_tet_[1]=nullptr;
-    }
+    void setTetrahedron(mesh_structure::index_t* tet[4]){ setElement(tet); }
 
-    ~TetrahedronMesh(){
-        if (nTetrahedron!=0){
-            delete []x_;
-            delete []y_;
-            delete []z_;
-            delete []boundary_;
-            delete []tet_[0];
-            delete []tet_[1];
-            delete []tet_[2];
-            delete []tet_[3];
-        }
-        if (nFace!=0){
-            for (int i=0; i<5; i++){
-                delete []faces_[i];
-            }
-            for (int i=0; i<4; i++){
-                delete []tet_face_conn_[i];
-            }
+    mesh_structure::index_t **tetrahedron()  { return elem_; }
+    mesh_structure::index_t **face_info() { return sub_; }   // index of 3 vertices and 2 neighboring tetrahedron for each face
+    mesh_structure::index_t **tet_face_connection() { return elem_sub_conn_; }
+    mesh_structure::local_t **face_order_in_tet() { return sub_order_; }    // order of face in 2 neighboring tetrahedron
+    mesh_structure::index_t **edge_info() { return edge_; }   // 2个顶点（升序）
+    mesh_structure::index_t **tet_edge_connection() { return elem_edge_conn_; }
 
-            delete []face_order_in_tet_[0];
-            delete []face_order_in_tet_[1];
-        }
-        nVertex=0;
-        nEdge=0;
-        nFace=0;
-        nTetrahedron=0;
-    }
+    void find_vertex_tetrahedron_connection(std::vector<unsigned long> *conn){ find_vertex_element_connection(conn); }
 
-    void read_off(const string &path) ;
+    mesh_structure::CsrView vertex_tetrahedron() { return vertex_element(); }
+    mesh_structure::CsrView vertex_face() { return vertex_sub(); }
+    mesh_structure::CsrView tetrahedron_tetrahedron() { return element_element(); }
 
-    unsigned long getNVertex(){  return nVertex; }
-    unsigned long getNFace(){  return nFace; }
-    unsigned long getNTetrahedron() { return nTetrahedron; }
-    unsigned long getNBoundary() { return nBoundary; }
-    unsigned long *boundary(){ return boundary_; }
-    double *x_coord(){  return x_; }
-    double *y_coord(){  return y_; }
-    double *z_coord(){  return z_; }
-    void setX(double* x){ for(unsigned long i=0; i<nVertex; i++){x_[i]= x[i];}}
-    void setY(double* y){ for(unsigned long i=0; i<nVertex; i++){y_[i]= y[i];}}
-    void setZ(double* z){ for(unsigned long i=0; i<nVertex; i++){z_[i]= z[i];}}
+    void collect_faces(){ collect_sub_entities(); }
+    void collect_edges(){ collect_mesh_edges(); }
 
-    void setTetrahedron(unsigned long* tet[4]){
-        for(int i=0; i< 4; ++i){
-            for(unsigned long j=0; j<nTetrahedron; j++){
-                tet_[i][j] = tet[i][j];
-            }
-        }
+    // 外存模式，见Mesh::collect_sub_entities_out_of_core
+    static void collect_faces_out_of_core(const string &off_path, const string &snapshot_path,
+                                          size_t memory_budget, const string &scratch_dir = "."){
+        collect_sub_entities_out_of_core(off_path, snapshot_path, memory_budget, scratch_dir);
     }
 
-    unsigned long **tetrahedron()  { return tet_; }
-    unsigned long **face_info() { return faces_; }
-    unsigned long **tet_face_connection() { return tet_face_conn_; }
-    unsigned long **face_order_in_tet() { return face_order_in_tet_; }
-
-    void find_vertex_tetrahedron_connection(std::vector<unsigned long> *conn);
-
-    void collect_faces();
-
-    void outputTecPlotDataFile(const char *fname);
+    double *tetrahedron_volume() { return elem_measure_; }
+    double **tetrahedron_centroid() { return elem_centroid_; }
+    double **face_normal() { return sub_normal_; }
+    double *face_area() { return sub_area_; }
 };    // TetrahedronMesh
 
+extern template class mesh_structure::Mesh<mesh_structure::TetrahedronTraits>;
+
 #endif //MESH_STRUCTURE_TEXT_TETRAHEDRONMESH_H
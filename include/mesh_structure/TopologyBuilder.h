@@ -0,0 +1,313 @@
+#ifndef MESH_STRUCTURE_TOPOLOGY_BUILDER_H
+#define MESH_STRUCTURE_TOPOLOGY_BUILDER_H
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "mesh_structure/Arena.h"
+#include "mesh_structure/Index.h"
+#include "mesh_structure/Parallel.h"
+
+namespace mesh_structure {
+
+// 子实体（三角形的边、四面体的面）提取结果
+// entity[0..SV-1]为按升序排列的顶点，entity[SV]为第一次遇到该子实体的单元，
+// entity[SV+1]为最后一次遇到的单元（边界上为nElement+1）
+// 所有数组都从调用者给出的ArrayArena分配，用完后放回同一个arena
+template <int NS, int SV>
+struct TopologyResult {
+    unsigned long nEntity;
+    unsigned long nBoundary;
+    index_t *entity[SV + 2];
+    index_t *conn[NS];           // conn[j][i]: 单元i的第j个子实体编号
+    local_t *order[2];           // 子实体在两侧单元中的局部序号，不存在时为NS
+    index_t *boundary;
+};
+
+namespace detail {
+
+// 对SV个顶点做插入排序
+template <int SV, class T>
+inline void sort_key(T *v) {
+    for (int a = 1; a < SV; ++a) {
+        T t = v[a];
+        int b = a - 1;
+        while (b >= 0 && v[b] > t) {
+            v[b + 1] = v[b];
+            --b;
+        }
+        v[b + 1] = t;
+    }
+}
+
+template <int SV, class T>
+inline unsigned long hash_key(const T *v) {
+    unsigned long h = 0x9e3779b97f4a7c15ul;
+    for (int a = 0; a < SV; ++a) {
+        h ^= v[a] + 0x9e3779b97f4a7c15ul + (h << 6) + (h >> 2);
+        h *= 0xff51afd7ed558ccdul;
+    }
+    return h ^ (h >> 32);
+}
+
+// 由entity和conn计算order与boundary，两条提取路径共用
+template <int NS, int SV>
+void finish_topology(unsigned long nElement, unsigned nthreads, TopologyResult<NS, SV> &out, ArrayArena &arena) {
+    const unsigned long n = out.nEntity;
+    const index_t *left = out.entity[SV], *right = out.entity[SV + 1];
+    out.order[0] = arena.allocate<local_t>(n);
+    out.order[1] = arena.allocate<local_t>(n);
+    parallel_for(0, n, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        for (unsigned long j = lo; j < hi; ++j) {
+            unsigned long ik = left[j], ik_ = right[j];
+            out.order[0][j] = out.order[1][j] = NS;
+            for (int i = 0; i < NS; ++i) {   // order of ik and ik_
+                if (out.conn[i][ik] == j) out.order[0][j] = i;
+                if (ik_ < nElement && out.conn[i][ik_] == j) out.order[1][j] = i;
+            }
+        }
+    });
+
+    // 边界：先分段计数，前缀和后按原顺序写入
+    std::vector<unsigned long> count(nthreads + 1, 0);
+    parallel_for(0, n, nthreads, [&](unsigned long lo, unsigned long hi, unsigned tid) {
+        unsigned long c = 0;
+        for (unsigned long j = lo; j < hi; ++j) c += right[j] == nElement + 1;
+        count[tid + 1] = c;
+    });
+    for (unsigned t = 0; t < nthreads; ++t) count[t + 1] += count[t];
+    out.nBoundary = count[nthreads];
+    out.boundary = arena.allocate<index_t>(out.nBoundary);
+    parallel_for(0, n, nthreads, [&](unsigned long lo, unsigned long hi, unsigned tid) {
+        unsigned long b = count[tid];
+        for (unsigned long j = lo; j < hi; ++j) {
+            if (right[j] == nElement + 1) out.boundary[b++] = j;
+        }
+    });
+}
+
+}  // namespace detail
+
+
+// 用开放寻址哈希表对子实体去重，键为排序后的顶点组
+// 内存只与子实体数成正比，没有每个顶点的子实体数上限
+// 子实体按第一次出现的顺序编号（单元优先，其次局部序号），与原逐顶点查找实现的编号完全相同
+template <int NS, int SV>
+void collect_topology_serial(unsigned long nElement, index_t *const *elem,
+                             const int (&local)[NS][SV], TopologyResult<NS, SV> &out, ArrayArena &arena) {
+    const unsigned long EMPTY = ~0ul;
+    std::vector<index_t> ent[SV + 2];
+
+    for (int j = 0; j < NS; ++j) out.conn[j] = arena.allocate<index_t>(nElement);
+
+    // 负载因子不超过1/2，表满时加倍并重建
+    unsigned long expect = NS * nElement / 2 + 16;
+    unsigned long cap = 16;
+    while (cap < 2 * expect) cap <<= 1;
+    std::vector<unsigned long> table(cap, EMPTY);
+    for (int a = 0; a < SV + 2; ++a) ent[a].reserve(expect);
+
+    unsigned long n = 0;
+    for (unsigned long i = 0; i < nElement; ++i) {   // 按单元循环
+        for (int j = 0; j < NS; ++j) {
+            index_t key[SV];
+            for (int a = 0; a < SV; ++a) key[a] = elem[local[j][a]][i];
+            detail::sort_key<SV>(key);
+
+            unsigned long mask = cap - 1;
+            unsigned long slot = detail::hash_key<SV>(key) & mask;
+            for (;;) {
+                unsigned long id = table[slot];
+                if (id == EMPTY) break;
+                bool same = true;
+                for (int a = 0; a < SV; ++a) {
+                    if (ent[a][id] != key[a]) { same = false; break; }
+                }
+                if (same) break;
+                slot = (slot + 1) & mask;
+            }
+
+            unsigned long id = table[slot];
+            if (id != EMPTY) {          // 子实体已经存在
+                ent[SV + 1][id] = i;
+                out.conn[j][i] = id;
+                continue;
+            }
+            // 子实体不存在
+            for (int a = 0; a < SV; ++a) ent[a].push_back(key[a]);
+            ent[SV].push_back(i);
+            ent[SV + 1].push_back(nElement + 1);
+            table[slot] = n;
+            out.conn[j][i] = n;
+            ++n;
+
+            if (2 * n > cap) {
+                cap <<= 1;
+                mask = cap - 1;
+                table.assign(cap, EMPTY);
+                for (unsigned long e = 0; e < n; ++e) {
+                    index_t k[SV];
+                    for (int a = 0; a < SV; ++a) k[a] = ent[a][e];
+                    unsigned long s = detail::hash_key<SV>(k) & mask;
+                    while (table[s] != EMPTY) s = (s + 1) & mask;
+                    table[s] = e;
+                }
+            }
+        }
+    }
+    std::vector<unsigned long>().swap(table);
+    check_index_range(n, "sub-entities");
+
+    out.nEntity = n;
+    for (int a = 0; a < SV + 2; ++a) {
+        out.entity[a] = arena.allocate<index_t>(n);
+        for (unsigned long e = 0; e < n; ++e) out.entity[a][e] = ent[a][e];
+        std::vector<index_t>().swap(ent[a]);
+    }
+    detail::finish_topology<NS, SV>(nElement, 1, out, arena);
+}
+
+
+// 并行提取：记录r = i*NS + j表示单元i的第j个子实体
+// 1. 按最小顶点对所有记录做计数排序（一趟MSD基数排序，计数/前缀和/填充均并行）
+// 2. 各桶内按(其余顶点, r)排序，相同子实体成为连续的一段，段内第一个记录的r最小
+// 3. 以conn数组为暂存，标记每段的最小记录并按r做并行前缀和，得到与串行路径相同的编号
+// 4. 并行写出entity与conn，再并行计算order和boundary
+// 结果与collect_topology_serial完全相同，额外内存约为每个记录(SV-1)*sizeof(index_t)+8字节
+template <int NS, int SV>
+void collect_topology_parallel(unsigned long nVertex, unsigned long nElement, index_t *const *elem,
+                               const int (&local)[NS][SV], unsigned nthreads, TopologyResult<NS, SV> &out,
+                               ArrayArena &arena) {
+    struct Record {
+        index_t rest[SV - 1];
+        unsigned long r;
+        bool operator<(const Record &o) const {
+            for (int a = 0; a < SV - 1; ++a) {
+                if (rest[a] != o.rest[a]) return rest[a] < o.rest[a];
+            }
+            return r < o.r;
+        }
+    };
+    const unsigned long nrecord = NS * nElement;
+    for (int j = 0; j < NS; ++j) out.conn[j] = arena.allocate<index_t>(nElement);
+
+    // 1. 计数排序
+    std::vector<unsigned long> offset(nVertex + 1, 0);
+    {
+        std::vector<std::atomic<unsigned long>> count(nVertex);
+        parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+            for (unsigned long i = lo; i < hi; ++i) {
+                for (int j = 0; j < NS; ++j) {
+                    index_t v0 = elem[local[j][0]][i];
+                    for (int a = 1; a < SV; ++a) v0 = std::min(v0, elem[local[j][a]][i]);
+                    count[v0].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+        parallel_for(0, nVertex, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+            for (unsigned long v = lo; v < hi; ++v) offset[v] = count[v].load(std::memory_order_relaxed);
+        });
+    }
+    parallel_exclusive_scan(offset.data(), nVertex + 1, nthreads);
+
+    std::vector<Record> rec(nrecord);
+    {
+        std::vector<std::atomic<unsigned long>> cursor(nVertex);
+        parallel_for(0, nVertex, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+            for (unsigned long v = lo; v < hi; ++v) cursor[v].store(offset[v], std::memory_order_relaxed);
+        });
+        parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+            for (unsigned long i = lo; i < hi; ++i) {
+                for (int j = 0; j < NS; ++j) {
+                    index_t key[SV];
+                    for (int a = 0; a < SV; ++a) key[a] = elem[local[j][a]][i];
+                    detail::sort_key<SV>(key);
+                    Record &rc = rec[cursor[key[0]].fetch_add(1, std::memory_order_relaxed)];
+                    for (int a = 1; a < SV; ++a) rc.rest[a - 1] = key[a];
+                    rc.r = i * NS + j;
+                }
+            }
+        });
+    }
+
+    // 2. 桶内排序，并在conn中标记每段的最小记录
+    auto same_key = [](const Record &a, const Record &b) {
+        for (int k = 0; k < SV - 1; ++k) {
+            if (a.rest[k] != b.rest[k]) return false;
+        }
+        return true;
+    };
+    parallel_for(0, nVertex, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        for (unsigned long v = lo; v < hi; ++v) {
+            Record *b = rec.data() + offset[v], *e = rec.data() + offset[v + 1];
+            std::sort(b, e);
+            for (Record *p = b; p < e; ++p) {
+                out.conn[p->r % NS][p->r / NS] = (p == b || !same_key(*p, p[-1])) ? 1 : 0;
+            }
+        }
+    });
+
+    // 3. 按r的顺序做前缀和，段首记录处的值即为子实体编号
+    std::vector<unsigned long> partial(nthreads + 1, 0);
+    parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned tid) {
+        unsigned long sum = 0;
+        for (unsigned long i = lo; i < hi; ++i)
+            for (int j = 0; j < NS; ++j) sum += out.conn[j][i];
+        partial[tid + 1] = sum;
+    });
+    for (unsigned t = 0; t < nthreads; ++t) partial[t + 1] += partial[t];
+    check_index_range(partial[nthreads], "sub-entities");
+    parallel_for(0, nElement, nthreads, [&](unsigned long lo, unsigned long hi, unsigned tid) {
+        unsigned long sum = partial[tid];
+        for (unsigned long i = lo; i < hi; ++i) {
+            for (int j = 0; j < NS; ++j) {
+                unsigned long f = out.conn[j][i];
+                out.conn[j][i] = sum;
+                sum += f;
+            }
+        }
+    });
+    const unsigned long n = partial[nthreads];
+
+    // 4. 写出子实体表和单元-子实体关系
+    out.nEntity = n;
+    for (int a = 0; a < SV + 2; ++a) out.entity[a] = arena.allocate<index_t>(n);
+    parallel_for(0, nVertex, nthreads, [&](unsigned long lo, unsigned long hi, unsigned) {
+        for (unsigned long v = lo; v < hi; ++v) {
+            Record *p = rec.data() + offset[v], *e = rec.data() + offset[v + 1];
+            while (p < e) {
+                Record *q = p + 1;
+                while (q < e && same_key(*q, *p)) ++q;
+                unsigned long id = out.conn[p->r % NS][p->r / NS];
+                out.entity[0][id] = v;
+                for (int a = 1; a < SV; ++a) out.entity[a][id] = p->rest[a - 1];
+                out.entity[SV][id] = p->r / NS;
+                out.entity[SV + 1][id] = q - p > 1 ? q[-1].r / NS : nElement + 1;
+                for (Record *t = p + 1; t < q; ++t) out.conn[t->r % NS][t->r / NS] = id;
+                p = q;
+            }
+        }
+    });
+    std::vector<Record>().swap(rec);
+    std::vector<unsigned long>().swap(offset);
+
+    detail::finish_topology<NS, SV>(nElement, nthreads, out, arena);
+}
+
+
+// nthreads <= 1时使用哈希去重，否则使用并行排序，两者结果相同
+template <int NS, int SV>
+void collect_topology(unsigned long nVertex, unsigned long nElement, index_t *const *elem,
+                      const int (&local)[NS][SV], unsigned nthreads, TopologyResult<NS, SV> &out,
+                      ArrayArena &arena) {
+    if (nthreads <= 1 || nElement < 4096) {
+        collect_topology_serial(nElement, elem, local, out, arena);
+    } else {
+        collect_topology_parallel(nVertex, nElement, elem, local, nthreads, out, arena);
+    }
+}
+
+}  // namespace mesh_structure
+
+#endif // MESH_STRUCTURE_TOPOLOGY_BUILDER_H
@@ -0,0 +1,105 @@
+#include "mesh_structure/GeometryKernels.h"
+#include "mesh_structure/Error.h"
+#include "mesh_structure/Parallel.h"
+
+#include <atomic>
+
+#include "GeometryKernelsImpl.h"
+
+namespace mesh_structure {
+
+namespace detail {
+
+const GeometryKernelTable scalar_kernels = make_kernel_table<ScalarOps>();
+
+}  // namespace detail
+
+namespace {
+
+SimdLevel detect_simd_level() {
+#ifdef MESH_STRUCTURE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdLevel::AVX2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+std::atomic<int> &current_level() {
+    static std::atomic<int> level(static_cast<int>(detect_simd_level()));
+    return level;
+}
+
+const detail::GeometryKernelTable &kernels() {
+    switch (static_cast<SimdLevel>(current_level().load(std::memory_order_relaxed))) {
+#ifdef MESH_STRUCTURE_X86_SIMD
+    case SimdLevel::AVX512: return detail::avx512_kernels;
+    case SimdLevel::AVX2: return detail::avx2_kernels;
+#endif
+    default: return detail::scalar_kernels;
+    }
+}
+
+}  // namespace
+
+
+SimdLevel max_simd_level() {
+    static const SimdLevel level = detect_simd_level();
+    return level;
+}
+
+SimdLevel simd_level() {
+    return static_cast<SimdLevel>(current_level().load(std::memory_order_relaxed));
+}
+
+void set_simd_level(SimdLevel level) {
+    if (static_cast<int>(level) > static_cast<int>(max_simd_level())) level = max_simd_level();
+    current_level().store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+const char *simd_level_name(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::AVX512: return "avx512";
+    case SimdLevel::AVX2: return "avx2";
+    default: return "scalar";
+    }
+}
+
+void triangle_normals(unsigned long n, const double *x, const double *y, const double *z,
+                      index_t *const *tri, double *const *normal, double *area, unsigned nthreads) {
+    const detail::GeometryKernelTable &k = kernels();
+    parallel_for(0, n, resolve_threads(nthreads), [&](unsigned long lo, unsigned long hi, unsigned) {
+        k.triangle_normals(lo, hi, x, y, z, tri, normal, area);
+    });
+}
+
+void tetrahedron_volumes(unsigned long n, const double *x, const double *y, const double *z,
+                         index_t *const *tet, double *volume, unsigned nthreads) {
+    const detail::GeometryKernelTable &k = kernels();
+    parallel_for(0, n, resolve_threads(nthreads), [&](unsigned long lo, unsigned long hi, unsigned) {
+        k.tetrahedron_volumes(lo, hi, x, y, z, tet, volume);
+    });
+}
+
+void element_centroids(unsigned long n, int nv, const double *x, const double *y, const double *z,
+                       index_t *const *elem, double *const *centroid, unsigned nthreads) {
+    if (nv != 3 && nv != 4) {
+        throw MeshError(error_message("element_centroids supports 3 or 4 vertices per element, got ", nv));
+    }
+    const detail::GeometryKernelTable &k = kernels();
+    auto f = nv == 3 ? k.centroids3 : k.centroids4;
+    parallel_for(0, n, resolve_threads(nthreads), [&](unsigned long lo, unsigned long hi, unsigned) {
+        f(lo, hi, x, y, z, elem, centroid);
+    });
+}
+
+void face_normals(unsigned long n, const double *x, const double *y, const double *z,
+                  index_t *const *face, const index_t *left, const double *const *cell_centroid,
+                  double *const *normal, double *area, unsigned nthreads) {
+    const detail::GeometryKernelTable &k = kernels();
+    parallel_for(0, n, resolve_threads(nthreads), [&](unsigned long lo, unsigned long hi, unsigned) {
+        k.face_normals(lo, hi, x, y, z, face, left, cell_centroid, normal, area);
+    });
+}
+
+}  // namespace mesh_structure
@@ -0,0 +1,36 @@
+// AVX2 + FMA 实现，本文件以 -mavx2 -mfma 编译，只在CPU支持时被调用
+#include <immintrin.h>
+
+#include "GeometryKernelsImpl.h"
+
+namespace {
+
+struct Avx2Ops {
+    typedef __m256d V;
+    static const unsigned long W = 4;
+    // 32位编号零扩展为64位后收集（32位收集指令按有符号数处理编号）
+    static V gather(const double *base, const mesh_structure::index_t *idx) {
+        if constexpr (sizeof(mesh_structure::index_t) == 4) {
+            __m128i i32 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(idx));
+            return _mm256_i64gather_pd(base, _mm256_cvtepu32_epi64(i32), 8);
+        } else {
+            return _mm256_i64gather_pd(base, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(idx)), 8);
+        }
+    }
+    static V load(const double *p) { return _mm256_loadu_pd(p); }
+    static void store(double *p, V v) { _mm256_storeu_pd(p, v); }
+    static V set1(double s) { return _mm256_set1_pd(s); }
+    static V sqrt(V v) { return _mm256_sqrt_pd(v); }
+    static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    static V flipsign(V v, V s) { return _mm256_xor_pd(v, _mm256_and_pd(s, _mm256_set1_pd(-0.0))); }
+};
+
+}  // namespace
+
+namespace mesh_structure {
+namespace detail {
+
+const GeometryKernelTable avx2_kernels = make_kernel_table<Avx2Ops>();
+
+}  // namespace detail
+}  // namespace mesh_structure
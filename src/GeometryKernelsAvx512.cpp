@@ -0,0 +1,39 @@
+// AVX-512F 实现，本文件以 -mavx512f 编译，只在CPU支持时被调用
+#include <immintrin.h>
+
+#include "GeometryKernelsImpl.h"
+
+namespace {
+
+struct Avx512Ops {
+    typedef __m512d V;
+    static const unsigned long W = 8;
+    static V gather(const double *base, const mesh_structure::index_t *idx) {
+        if constexpr (sizeof(mesh_structure::index_t) == 4) {
+            __m256i i32 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(idx));
+            return _mm512_i64gather_pd(_mm512_cvtepu32_epi64(i32), base, 8);
+        } else {
+            return _mm512_i64gather_pd(_mm512_loadu_si512(idx), base, 8);
+        }
+    }
+    static V load(const double *p) { return _mm512_loadu_pd(p); }
+    static void store(double *p, V v) { _mm512_storeu_pd(p, v); }
+    static V set1(double s) { return _mm512_set1_pd(s); }
+    static V sqrt(V v) { return _mm512_sqrt_pd(v); }
+    static V max(V a, V b) { return _mm512_max_pd(a, b); }
+    static V flipsign(V v, V s) {
+        // AVX-512F没有浮点的按位运算，借用整数指令
+        __m512i sign = _mm512_and_si512(_mm512_castpd_si512(s), _mm512_set1_epi64(0x8000000000000000ll));
+        return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(v), sign));
+    }
+};
+
+}  // namespace
+
+namespace mesh_structure {
+namespace detail {
+
+const GeometryKernelTable avx512_kernels = make_kernel_table<Avx512Ops>();
+
+}  // namespace detail
+}  // namespace mesh_structure
@@ -0,0 +1,173 @@
+#ifndef MESH_STRUCTURE_GEOMETRY_KERNELS_IMPL_H
+#define MESH_STRUCTURE_GEOMETRY_KERNELS_IMPL_H
+
+// 几何核函数的公共实现，由各指令集的源文件分别包含并以不同的编译选项编译
+// 每个源文件定义自己的向量类型S（位于匿名命名空间），这里的模板按S实例化，互不冲突
+// S需要提供：V（支持+-*/的向量类型）、W（宽度）、gather、load、store、set1、sqrt、max、flipsign
+
+#include <cfloat>
+#include <cmath>
+
+#include "mesh_structure/Index.h"
+
+namespace mesh_structure {
+namespace detail {
+
+// 各指令集实现的核函数表，处理区间[lo, hi)
+struct GeometryKernelTable {
+    void (*triangle_normals)(unsigned long lo, unsigned long hi, const double *x, const double *y, const double *z,
+                             index_t *const *tri, double *const *normal, double *area);
+    void (*tetrahedron_volumes)(unsigned long lo, unsigned long hi, const double *x, const double *y,
+                                const double *z, index_t *const *tet, double *volume);
+    void (*centroids3)(unsigned long lo, unsigned long hi, const double *x, const double *y, const double *z,
+                       index_t *const *elem, double *const *centroid);
+    void (*centroids4)(unsigned long lo, unsigned long hi, const double *x, const double *y, const double *z,
+                       index_t *const *elem, double *const *centroid);
+    void (*face_normals)(unsigned long lo, unsigned long hi, const double *x, const double *y, const double *z,
+                         index_t *const *face, const index_t *left, const double *const *cell_centroid,
+                         double *const *normal, double *area);
+};
+
+extern const GeometryKernelTable scalar_kernels;
+#ifdef MESH_STRUCTURE_X86_SIMD
+extern const GeometryKernelTable avx2_kernels;
+extern const GeometryKernelTable avx512_kernels;
+#endif
+
+}  // namespace detail
+}  // namespace mesh_structure
+
+namespace {
+
+using mesh_structure::index_t;
+
+// 宽度为1的标量实现，用于处理向量循环剩余的尾部
+struct ScalarOps {
+    typedef double V;
+    static const unsigned long W = 1;
+    static V gather(const double *base, const index_t *idx) { return base[*idx]; }
+    static V load(const double *p) { return *p; }
+    static void store(double *p, V v) { *p = v; }
+    static V set1(double s) { return s; }
+    static V sqrt(V v) { return std::sqrt(v); }
+    static V max(V a, V b) { return a > b ? a : b; }
+    static V flipsign(V v, V s) { return s < 0 ? -v : v; }
+};
+
+template <class S>
+inline void triangle_normal_step(unsigned long i, const double *x, const double *y, const double *z,
+                                 index_t *const *tri, double *const *normal, double *area) {
+    typedef typename S::V V;
+    V x0 = S::gather(x, tri[0] + i), y0 = S::gather(y, tri[0] + i), z0 = S::gather(z, tri[0] + i);
+    V ux = S::gather(x, tri[1] + i) - x0, uy = S::gather(y, tri[1] + i) - y0, uz = S::gather(z, tri[1] + i) - z0;
+    V vx = S::gather(x, tri[2] + i) - x0, vy = S::gather(y, tri[2] + i) - y0, vz = S::gather(z, tri[2] + i) - z0;
+    V cx = uy * vz - uz * vy;
+    V cy = uz * vx - ux * vz;
+    V cz = ux * vy - uy * vx;
+    V len = S::sqrt(cx * cx + cy * cy + cz * cz);
+    V inv = S::set1(1.0) / S::max(len, S::set1(DBL_MIN));   // 退化三角形的法向量为0
+    S::store(normal[0] + i, cx * inv);
+    S::store(normal[1] + i, cy * inv);
+    S::store(normal[2] + i, cz * inv);
+    S::store(area + i, S::set1(0.5) * len);
+}
+
+template <class S>
+inline void tetrahedron_volume_step(unsigned long i, const double *x, const double *y, const double *z,
+                                    index_t *const *tet, double *volume) {
+    typedef typename S::V V;
+    V x0 = S::gather(x, tet[0] + i), y0 = S::gather(y, tet[0] + i), z0 = S::gather(z, tet[0] + i);
+    V ax = S::gather(x, tet[1] + i) - x0, ay = S::gather(y, tet[1] + i) - y0, az = S::gather(z, tet[1] + i) - z0;
+    V bx = S::gather(x, tet[2] + i) - x0, by = S::gather(y, tet[2] + i) - y0, bz = S::gather(z, tet[2] + i) - z0;
+    V cx = S::gather(x, tet[3] + i) - x0, cy = S::gather(y, tet[3] + i) - y0, cz = S::gather(z, tet[3] + i) - z0;
+    V det = ax * (by * cz - bz * cy) + ay * (bz * cx - bx * cz) + az * (bx * cy - by * cx);
+    S::store(volume + i, det * S::set1(1.0 / 6.0));
+}
+
+template <class S, int NV>
+inline void centroid_step(unsigned long i, const double *x, const double *y, const double *z,
+                          index_t *const *elem, double *const *centroid) {
+    typedef typename S::V V;
+    V sx = S::gather(x, elem[0] + i), sy = S::gather(y, elem[0] + i), sz = S::gather(z, elem[0] + i);
+    for (int j = 1; j < NV; ++j) {
+        sx = sx + S::gather(x, elem[j] + i);
+        sy = sy + S::gather(y, elem[j] + i);
+        sz = sz + S::gather(z, elem[j] + i);
+    }
+    V inv = S::set1(1.0 / NV);
+    S::store(centroid[0] + i, sx * inv);
+    S::store(centroid[1] + i, sy * inv);
+    S::store(centroid[2] + i, sz * inv);
+}
+
+template <class S>
+inline void face_normal_step(unsigned long i, const double *x, const double *y, const double *z,
+                             index_t *const *face, const index_t *left, const double *const *cell_centroid,
+                             double *const *normal, double *area) {
+    typedef typename S::V V;
+    V x0 = S::gather(x, face[0] + i), y0 = S::gather(y, face[0] + i), z0 = S::gather(z, face[0] + i);
+    V x1 = S::gather(x, face[1] + i), y1 = S::gather(y, face[1] + i), z1 = S::gather(z, face[1] + i);
+    V x2 = S::gather(x, face[2] + i), y2 = S::gather(y, face[2] + i), z2 = S::gather(z, face[2] + i);
+    V ux = x1 - x0, uy = y1 - y0, uz = z1 - z0;
+    V vx = x2 - x0, vy = y2 - y0, vz = z2 - z0;
+    V cx = uy * vz - uz * vy;
+    V cy = uz * vx - ux * vz;
+    V cz = ux * vy - uy * vx;
+    // 面形心减去左侧单元形心，与法向量反向时翻转法向量
+    V third = S::set1(1.0 / 3.0);
+    V dx = (x0 + x1 + x2) * third - S::gather(cell_centroid[0], left + i);
+    V dy = (y0 + y1 + y2) * third - S::gather(cell_centroid[1], left + i);
+    V dz = (z0 + z1 + z2) * third - S::gather(cell_centroid[2], left + i);
+    V s = cx * dx + cy * dy + cz * dz;
+    V len = S::sqrt(cx * cx + cy * cy + cz * cz);
+    V inv = S::flipsign(S::set1(1.0) / S::max(len, S::set1(DBL_MIN)), s);
+    S::store(normal[0] + i, cx * inv);
+    S::store(normal[1] + i, cy * inv);
+    S::store(normal[2] + i, cz * inv);
+    S::store(area + i, S::set1(0.5) * len);
+}
+
+// 向量循环加标量尾部
+template <class S>
+void triangle_normals_range(unsigned long lo, unsigned long hi, const double *x, const double *y, const double *z,
+                            index_t *const *tri, double *const *normal, double *area) {
+    unsigned long i = lo;
+    for (; i + S::W <= hi; i += S::W) triangle_normal_step<S>(i, x, y, z, tri, normal, area);
+    for (; i < hi; ++i) triangle_normal_step<ScalarOps>(i, x, y, z, tri, normal, area);
+}
+
+template <class S>
+void tetrahedron_volumes_range(unsigned long lo, unsigned long hi, const double *x, const double *y,
+                               const double *z, index_t *const *tet, double *volume) {
+    unsigned long i = lo;
+    for (; i + S::W <= hi; i += S::W) tetrahedron_volume_step<S>(i, x, y, z, tet, volume);
+    for (; i < hi; ++i) tetrahedron_volume_step<ScalarOps>(i, x, y, z, tet, volume);
+}
+
+template <class S, int NV>
+void centroids_range(unsigned long lo, unsigned long hi, const double *x, const double *y, const double *z,
+                     index_t *const *elem, double *const *centroid) {
+    unsigned long i = lo;
+    for (; i + S::W <= hi; i += S::W) centroid_step<S, NV>(i, x, y, z, elem, centroid);
+    for (; i < hi; ++i) centroid_step<ScalarOps, NV>(i, x, y, z, elem, centroid);
+}
+
+template <class S>
+void face_normals_range(unsigned long lo, unsigned long hi, const double *x, const double *y, const double *z,
+                        index_t *const *face, const index_t *left, const double *const *cell_centroid,
+                        double *const *normal, double *area) {
+    unsigned long i = lo;
+    for (; i + S::W <= hi; i += S::W) face_normal_step<S>(i, x, y, z, face, left, cell_centroid, normal, area);
+    for (; i < hi; ++i) face_normal_step<ScalarOps>(i, x, y, z, face, left, cell_centroid, normal, area);
+}
+
+// 只含函数地址，是常量表达式，各表在静态初始化阶段即已就绪
+template <class S>
+constexpr mesh_structure::detail::GeometryKernelTable make_kernel_table() {
+    return {&triangle_normals_range<S>, &tetrahedron_volumes_range<S>, &centroids_range<S, 3>,
+            &centroids_range<S, 4>, &face_normals_range<S>};
+}
+
+}  // namespace
+
+#endif // MESH_STRUCTURE_GEOMETRY_KERNELS_IMPL_H
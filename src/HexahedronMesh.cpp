@@ -0,0 +1,7 @@
+#include "mesh_structure/HexahedronMesh.h"
+#include "mesh_structure/QuadrilateralMesh.h"
+#include "mesh_structure/MeshImpl.h"
+
+template class mesh_structure::Mesh<mesh_structure::HexahedronTraits>;
+template void mesh_structure::Mesh<mesh_structure::HexahedronTraits>::extract_boundary(
+    mesh_structure::Mesh<mesh_structure::QuadrilateralTraits> &, mesh_structure::SurfaceMap &, double);
@@ -0,0 +1,4 @@
+#include "mesh_structure/QuadrilateralMesh.h"
+#include "mesh_structure/MeshImpl.h"
+
+template class mesh_structure::Mesh<mesh_structure::QuadrilateralTraits>;